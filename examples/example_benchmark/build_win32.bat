@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Release
+cl /nologo /Zi /MD /O2 /I ..\.. %* *.cpp ..\..\*.cpp /FeRelease/example_benchmark.exe /FoRelease/ /link gdi32.lib shell32.lib
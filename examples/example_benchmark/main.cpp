@@ -0,0 +1,1666 @@
+// dear imgui: headless benchmark application
+// (compile and link imgui, create context, run scripted workloads headless with NO INPUTS, NO GRAPHICS OUTPUT)
+// Each workload is replayed for a fixed number of frames in its own context. We measure the CPU time spent in
+// NewFrame(), in the workload submission code, in EndFrame() and in Render(), and gather vertex/index/draw
+// command counts from ImDrawData. Micro-benchmarks time a single low-level function (e.g. ID hashing).
+// Results are printed as JSON so they can be compared across builds.
+//
+// Usage:
+//   example_benchmark [--frames N] [--warmup N] [--workload NAME]... [--micro NAME]... [--output FILE] [--list]
+//                     [--defer-tessellation] [--threads N] [--text-cache BYTES] [--draw-data-arena] [--merge-commands] [--cpu-clip]
+//                     [--check-allocations]
+// When neither --workload nor --micro are specified, everything is run.
+// --defer-tessellation enables io.ConfigDrawListsDeferTessellation, --threads N sets io.ParallelForFn to use N threads (including the main thread).
+// --text-cache BYTES sets io.ConfigTextCacheBudget.
+// --draw-data-arena sets ImGuiBackendFlags_RendererHasDrawDataArena (Render() also copies the frame into single vertex/index buffers).
+// --merge-commands enables io.ConfigDrawDataMergeCommands (implies --draw-data-arena). --cpu-clip enables io.ConfigDrawListsCpuClipRect.
+// Build with optimizations enabled (the Makefile and build_win32.bat do) or the numbers won't mean much.
+// Build with IMGUI_ENABLE_PROFILER defined (e.g. 'make WITH_PROFILER=1') to also report per-zone timings.
+// --check-allocations exits with an error if any measured (post warm-up) frame made a heap allocation, except for workloads which
+// document why they allocate (see BenchWorkload::AllocsReason), so it can run over all workloads as a CI check, e.g.:
+//   example_benchmark --frames 1000 --check-allocations
+// Build with IMGUI_ENABLE_ALLOC_TRACKING defined (e.g. 'make WITH_ALLOC_TRACKING=1') to also report the call sites of those allocations.
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+typedef std::chrono::high_resolution_clock BenchClock;
+
+static double GetElapsedMs(BenchClock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - t0).count();
+}
+
+struct BenchPhaseStats
+{
+    std::vector<double> Samples;
+
+    void    Add(double ms)  { Samples.push_back(ms); }
+    double  Mean() const    { double sum = 0.0; for (size_t n = 0; n < Samples.size(); n++) sum += Samples[n]; return Samples.empty() ? 0.0 : sum / (double)Samples.size(); }
+    double  Percentile(double p) const
+    {
+        if (Samples.empty())
+            return 0.0;
+        std::vector<double> sorted = Samples;
+        std::sort(sorted.begin(), sorted.end());
+        size_t idx = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+        return sorted[idx];
+    }
+};
+
+// Simple deterministic random generator so all runs submit the exact same data
+static unsigned int BenchRand(unsigned int* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+// Minimal thread pool implementing io.ParallelForFn (the calling thread runs jobs as well)
+struct BenchThreadPool
+{
+    std::vector<std::thread>    Threads;
+    std::mutex                  Mutex;
+    std::condition_variable     WakeCond;
+    std::condition_variable     DoneCond;
+    void                        (*Job)(void* job_data, int index);
+    void*                       JobData;
+    int                         JobCount;
+    std::atomic<int>            JobNext;
+    int                         Generation;
+    int                         WorkersBusy;
+    bool                        Quit;
+
+    BenchThreadPool(int threads_count) : Job(NULL), JobData(NULL), JobCount(0), JobNext(0), Generation(0), WorkersBusy(0), Quit(false)
+    {
+        for (int n = 1; n < threads_count; n++)
+            Threads.push_back(std::thread(&BenchThreadPool::WorkerMain, this));
+    }
+    ~BenchThreadPool()
+    {
+        { std::lock_guard<std::mutex> lock(Mutex); Quit = true; }
+        WakeCond.notify_all();
+        for (size_t n = 0; n < Threads.size(); n++)
+            Threads[n].join();
+    }
+    void RunJobs()
+    {
+        for (int index = JobNext++; index < JobCount; index = JobNext++)
+            Job(JobData, index);
+    }
+    void WorkerMain()
+    {
+        int generation = 0;
+        std::unique_lock<std::mutex> lock(Mutex);
+        while (true)
+        {
+            WakeCond.wait(lock, [&] { return Quit || Generation != generation; });
+            if (Quit)
+                return;
+            generation = Generation;
+            lock.unlock();
+            RunJobs();
+            lock.lock();
+            if (--WorkersBusy == 0)
+                DoneCond.notify_one();
+        }
+    }
+    static void ParallelFor(void* user_data, int count, void (*job)(void* job_data, int index), void* job_data)
+    {
+        BenchThreadPool* pool = (BenchThreadPool*)user_data;
+        {
+            std::lock_guard<std::mutex> lock(pool->Mutex);
+            pool->Job = job;
+            pool->JobData = job_data;
+            pool->JobCount = count;
+            pool->JobNext = 0;
+            pool->WorkersBusy = (int)pool->Threads.size();
+            pool->Generation++;
+        }
+        pool->WakeCond.notify_all();
+        pool->RunJobs();
+        std::unique_lock<std::mutex> lock(pool->Mutex);
+        pool->DoneCond.wait(lock, [&] { return pool->WorkersBusy == 0; });
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Workloads
+//-----------------------------------------------------------------------------
+
+// Full demo window, with the metrics window and the style editor as well
+static void Workload_Demo(int)
+{
+    ImGui::ShowDemoWindow(NULL);
+    ImGui::ShowMetricsWindow(NULL);
+    ImGui::Begin("Style Editor");
+    ImGui::ShowStyleEditor();
+    ImGui::End();
+}
+
+// Thousands of small windows with a few widgets each
+static void Workload_Windows(int)
+{
+    const int WINDOWS_COUNT = 2000;
+    static float values[WINDOWS_COUNT] = {};
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+    {
+        char name[32];
+        sprintf(name, "Window %04d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)((n % 40) * 45), (float)((n / 40) * 20)), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(160, 90), ImGuiCond_Always);
+        ImGui::Begin(name);
+        ImGui::Text("Item %d", n);
+        ImGui::SliderFloat("value", &values[n], 0.0f, 1.0f);
+        ImGui::Button("Button");
+        ImGui::End();
+    }
+}
+
+// 10k windows with a single line of text, to measure the per-window cost of Begin()/End()
+static void Workload_Windows10k(int)
+{
+    const int WINDOWS_COUNT = 10000;
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+    {
+        char name[32];
+        sprintf(name, "Window %05d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)((n % 100) * 19), (float)((n / 100) * 10)), ImGuiCond_Always);
+        ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::TextUnformatted("Text");
+        ImGui::End();
+    }
+}
+
+// 10k child windows in a single scrolling window (e.g. an asset browser using BeginChild() for each row)
+static void Workload_Children10k(int frame)
+{
+    const int CHILDREN_COUNT = 10000;
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Asset Browser");
+    for (int n = 0; n < CHILDREN_COUNT; n++)
+    {
+        ImGui::PushID(n);
+        ImGui::BeginChild("row", ImVec2(0, 40), false);
+        ImGui::Text("Asset %d", n);
+        ImGui::EndChild();
+        ImGui::PopID();
+    }
+    ImGui::SetScrollY((float)((frame * 37) % CHILDREN_COUNT) * 44.0f);
+    ImGui::End();
+}
+
+// Large list of rows using columns and the list clipper, scrolling a little bit every frame
+static void Workload_Table(int frame)
+{
+    const int ROWS_COUNT = 100000;
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Table");
+    ImGui::Columns(4, "table_columns");
+    ImGuiListClipper clipper(ROWS_COUNT);
+    while (clipper.Step())
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+        {
+            ImGui::Text("Row %d", row); ImGui::NextColumn();
+            ImGui::Text("0x%08X", row * 2654435761u); ImGui::NextColumn();
+            ImGui::Text("%.3f", row * 0.001f); ImGui::NextColumn();
+            ImGui::Selectable("Select##row", false, ImGuiSelectableFlags_SpanAllColumns, ImVec2(0, 0)); ImGui::NextColumn();
+        }
+    ImGui::Columns(1);
+    ImGui::SetScrollY((float)((frame * 97) % 100000) * ImGui::GetTextLineHeightWithSpacing());
+    ImGui::End();
+}
+
+// Huge text block submitted as a single TextUnformatted() call
+static ImGuiTextBuffer* g_TextBlock = NULL;
+static void Workload_Text(int frame)
+{
+    if (g_TextBlock == NULL)
+    {
+        g_TextBlock = new ImGuiTextBuffer();
+        unsigned int seed = 1;
+        for (int line = 0; line < 50000; line++)
+            g_TextBlock->appendf("[%05d] %08X Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.\n", line, BenchRand(&seed));
+    }
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Text");
+    ImGui::SetScrollY((float)((frame * 131) % 50000) * ImGui::GetTextLineHeight());
+    ImGui::TextUnformatted(g_TextBlock->begin(), g_TextBlock->end());
+    ImGui::End();
+}
+
+// Log viewer scrolled to the bottom of a 500k lines (~50 MB) buffer, growing by 100 lines every frame
+static ImGuiTextBuffer* g_LogBuffer = NULL;
+static ImGuiTextIndex* g_LogIndex = NULL;
+static void Workload_LogEx(int frame, bool indexed)
+{
+    const int LINES_COUNT = 500000;
+    if (g_LogBuffer == NULL)
+    {
+        g_LogBuffer = new ImGuiTextBuffer();
+        g_LogBuffer->reserve(LINES_COUNT * 110);
+        g_LogIndex = new ImGuiTextIndex();
+    }
+    if (frame == 0)
+    {
+        // Each workload restarts from the same buffer
+        g_LogBuffer->clear();
+        g_LogIndex->clear();
+        unsigned int seed = 2;
+        for (int line = 0; line < LINES_COUNT; line++)
+            g_LogBuffer->appendf("[%06d] %08X Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.\n", line, BenchRand(&seed));
+    }
+    unsigned int seed = (unsigned int)frame;
+    for (int line = 0; line < 100; line++)
+        g_LogBuffer->appendf("[frame %05d] %08X Appended line.\n", frame, BenchRand(&seed));
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Log");
+    if (indexed)
+        ImGui::TextUnformattedIndexed(g_LogBuffer->begin(), g_LogBuffer->end(), g_LogIndex);
+    else
+        ImGui::TextUnformatted(g_LogBuffer->begin(), g_LogBuffer->end());
+    ImGui::SetScrollHereY(1.0f);
+    ImGui::End();
+}
+static void Workload_Log(int frame)         { Workload_LogEx(frame, false); }
+static void Workload_LogIndexed(int frame)  { Workload_LogEx(frame, true); }
+
+// Dense plots
+static float* g_PlotData = NULL;
+static void Workload_Plots(int frame)
+{
+    const int PLOTS_COUNT = 32;
+    const int SAMPLES_COUNT = 4096;
+    if (g_PlotData == NULL)
+    {
+        g_PlotData = new float[PLOTS_COUNT * SAMPLES_COUNT];
+        unsigned int seed = 2;
+        for (int n = 0; n < PLOTS_COUNT * SAMPLES_COUNT; n++)
+            g_PlotData[n] = sinf(n * 0.01f) + (float)(BenchRand(&seed) % 1000) * 0.0005f;
+    }
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Plots");
+    for (int n = 0; n < PLOTS_COUNT; n++)
+    {
+        ImGui::PushID(n);
+        const float* values = g_PlotData + n * SAMPLES_COUNT;
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        if (n & 1)
+            ImGui::PlotHistogram("##histogram", values, SAMPLES_COUNT, frame % SAMPLES_COUNT, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 30));
+        else
+            ImGui::PlotLines("##lines", values, SAMPLES_COUNT, frame % SAMPLES_COUNT, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 30));
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+// Million-sample plots decimated with SetNextPlotDataVersion(). The first one scrolls every frame (values_offset) and is modified every 60 frames.
+static float* g_PlotData1M = NULL;
+static void Workload_Plots1M(int frame)
+{
+    const int PLOTS_COUNT = 4;
+    const int SAMPLES_COUNT = 1000000;
+    if (g_PlotData1M == NULL)
+    {
+        g_PlotData1M = new float[PLOTS_COUNT * SAMPLES_COUNT];
+        unsigned int seed = 3;
+        for (int n = 0; n < PLOTS_COUNT * SAMPLES_COUNT; n++)
+            g_PlotData1M[n] = sinf(n * 0.00001f) + (float)(BenchRand(&seed) % 1000) * 0.0005f;
+    }
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("Plots 1M");
+    for (int n = 0; n < PLOTS_COUNT; n++)
+    {
+        ImGui::PushID(n);
+        const float* values = g_PlotData1M + n * SAMPLES_COUNT;
+        const bool streaming = (n == 0);
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::SetNextPlotDataVersion(streaming ? frame / 60 : 0);
+        if (n & 1)
+            ImGui::PlotHistogram("##histogram", values, SAMPLES_COUNT, streaming ? frame % SAMPLES_COUNT : 0, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 100));
+        else
+            ImGui::PlotLines("##lines", values, SAMPLES_COUNT, streaming ? frame % SAMPLES_COUNT : 0, NULL, FLT_MAX, FLT_MAX, ImVec2(0, 100));
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+// Many visible tool windows, each drawing plots, custom shapes and text (use with --defer-tessellation and --threads)
+static void Workload_ToolWindows(int frame)
+{
+    const int WINDOWS_COUNT = 36;
+    const int SAMPLES_COUNT = 1024;
+    static float samples[SAMPLES_COUNT];
+    for (int n = 0; n < SAMPLES_COUNT; n++)
+        samples[n] = sinf((n + frame) * 0.05f) * cosf(n * 0.013f);
+    for (int window_n = 0; window_n < WINDOWS_COUNT; window_n++)
+    {
+        char name[32];
+        sprintf(name, "Tool %02d", window_n);
+        ImGui::SetNextWindowPos(ImVec2((float)((window_n % 6) * 320), (float)((window_n / 6) * 180)), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(320, 180), ImGuiCond_Always);
+        ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::PlotLines("##samples", samples, SAMPLES_COUNT, window_n * 7, NULL, -1.0f, 1.0f, ImVec2(0, 40));
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        ImVec2 p = ImGui::GetCursorScreenPos();
+        ImVec2 points[64];
+        for (int n = 0; n < IM_ARRAYSIZE(points); n++)
+            points[n] = ImVec2(p.x + n * 4.5f, p.y + 20.0f + samples[(n * 16 + window_n) % SAMPLES_COUNT] * 18.0f);
+        draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 200, 0, 255), false, 2.5f);
+        for (int n = 0; n < 8; n++)
+            draw_list->AddCircleFilled(ImVec2(p.x + 20.0f + n * 36.0f, p.y + 50.0f), 10.0f, IM_COL32(80, 160, 255, 200));
+        ImGui::Dummy(ImVec2(0, 64));
+        for (int line = 0; line < 12; line++)
+            ImGui::Text("%s line %d: value = %.3f, index = %d", name, line, samples[(line * 31 + frame) % SAMPLES_COUNT], line * window_n);
+        ImGui::End();
+    }
+}
+
+// Same tool windows with ImGuiWindowFlags_CacheContents: contents are static, except for one window updated every frame
+static void Workload_CachedTools(int frame)
+{
+    const int WINDOWS_COUNT = 36;
+    const int SAMPLES_COUNT = 1024;
+    static float samples[SAMPLES_COUNT];
+    for (int n = 0; n < SAMPLES_COUNT; n++)
+        samples[n] = sinf(n * 0.05f) * cosf(n * 0.013f);
+    for (int window_n = 0; window_n < WINDOWS_COUNT; window_n++)
+    {
+        char name[32];
+        sprintf(name, "Cached %02d", window_n);
+        const int version = (window_n == frame % WINDOWS_COUNT) ? frame : 0;
+        ImGui::SetNextWindowPos(ImVec2((float)((window_n % 6) * 320), (float)((window_n / 6) * 180)), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(320, 180), ImGuiCond_Always);
+        ImGui::SetNextWindowContentHash((ImGuiID)version);
+        if (ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_CacheContents))
+        {
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            ImGui::PlotLines("##samples", samples, SAMPLES_COUNT, window_n * 7, NULL, -1.0f, 1.0f, ImVec2(0, 40));
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            ImVec2 p = ImGui::GetCursorScreenPos();
+            ImVec2 points[64];
+            for (int n = 0; n < IM_ARRAYSIZE(points); n++)
+                points[n] = ImVec2(p.x + n * 4.5f, p.y + 20.0f + samples[(n * 16 + window_n) % SAMPLES_COUNT] * 18.0f);
+            draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 200, 0, 255), false, 2.5f);
+            for (int n = 0; n < 8; n++)
+                draw_list->AddCircleFilled(ImVec2(p.x + 20.0f + n * 36.0f, p.y + 50.0f), 10.0f, IM_COL32(80, 160, 255, 200));
+            ImGui::Dummy(ImVec2(0, 64));
+            for (int line = 0; line < 12; line++)
+                ImGui::Text("%s line %d: value = %.3f, version = %d", name, line, samples[(line * 31) % SAMPLES_COUNT], version);
+        }
+        ImGui::End();
+    }
+}
+
+struct BenchWorkload
+{
+    const char* Name;
+    const char* Desc;
+    void        (*Submit)(int frame);
+    const char* AllocsReason;       // Why measured frames may allocate, these allocations are reported but don't fail --check-allocations (NULL: none expected)
+};
+
+static const BenchWorkload g_Workloads[] =
+{
+    { "demo",         "ShowDemoWindow() + ShowMetricsWindow() + ShowStyleEditor()", Workload_Demo, NULL },
+    { "windows",      "2000 windows with a few widgets each",                       Workload_Windows, NULL },
+    { "windows_10k",  "10k windows with a single line of text",                     Workload_Windows10k, NULL },
+    { "children_10k", "10k child windows in a single window",                       Workload_Children10k, "each child draw list grows when the child first scrolls into view (or is first fully visible), which takes ~3000 frames for 10k children" },
+    { "table",        "100k rows in 4 columns using ImGuiListClipper",              Workload_Table, NULL },
+    { "text",         "50k lines of text in a single TextUnformatted() call",       Workload_Text, NULL },
+    { "log",          "500k lines log growing 100 lines/frame, TextUnformatted()",  Workload_Log, NULL },
+    { "log_indexed",  "Same as log using TextUnformattedIndexed()",                 Workload_LogIndexed, NULL },
+    { "plots",        "32 PlotLines/PlotHistogram of 4096 samples each",            Workload_Plots, NULL },
+    { "plots_1m",     "4 decimated PlotLines/PlotHistogram of 1M samples each",     Workload_Plots1M, NULL },
+    { "tool_windows", "36 visible windows with plots, custom shapes and text",      Workload_ToolWindows, NULL },
+    { "cached_tools", "Same as tool_windows with CacheContents, 1 updated/frame",   Workload_CachedTools, NULL },
+};
+
+//-----------------------------------------------------------------------------
+// Micro-benchmarks
+//-----------------------------------------------------------------------------
+
+struct BenchMetric
+{
+    const char* Name;
+    double      Value;
+};
+
+struct BenchMicroResult
+{
+    std::vector<BenchMetric> Metrics;
+
+    void    Add(const char* name, double value) { BenchMetric metric = { name, value }; Metrics.push_back(metric); }
+};
+
+// Call 'func' over and over until at least 'min_ms' elapsed, return the number of calls per second.
+template<typename T>
+static double MeasureCallsPerSecond(T func, int calls_per_batch, double min_ms = 100.0)
+{
+    func(); // Warm-up caches
+    long long calls = 0;
+    BenchClock::time_point t0 = BenchClock::now();
+    double elapsed_ms = 0.0;
+    do
+    {
+        func();
+        calls += calls_per_batch;
+        elapsed_ms = GetElapsedMs(t0);
+    } while (elapsed_ms < min_ms);
+    return (double)calls * 1000.0 / elapsed_ms;
+}
+
+// Labels roughly following the distribution of a typical tool UI: short words, "##" hidden labels,
+// formatted labels with a counter, a few longer sentences and a few "label###id" (e.g. window titles).
+static void BuildLabelCorpus(std::vector<std::string>* out_labels, int count)
+{
+    static const char* words[] = { "OK", "Cancel", "Apply", "Enabled", "Color", "Width", "Height", "Position", "Rotation", "Scale", "Name", "Visible", "Open", "Delete", "Settings" };
+    static const char* hidden[] = { "##slider", "##combo", "##value", "##filter", "##input", "##checkbox" };
+    unsigned int seed = 3;
+    char buf[128];
+    for (int n = 0; n < count; n++)
+    {
+        unsigned int r = BenchRand(&seed) % 100;
+        if (r < 40)
+            snprintf(buf, sizeof(buf), "%s", words[BenchRand(&seed) % IM_ARRAYSIZE(words)]);
+        else if (r < 60)
+            snprintf(buf, sizeof(buf), "%s", hidden[BenchRand(&seed) % IM_ARRAYSIZE(hidden)]);
+        else if (r < 85)
+            snprintf(buf, sizeof(buf), "%s %d", words[BenchRand(&seed) % IM_ARRAYSIZE(words)], BenchRand(&seed) % 1000);
+        else if (r < 95)
+            snprintf(buf, sizeof(buf), "Enable the %s of the selected objects (%d)", words[BenchRand(&seed) % IM_ARRAYSIZE(words)], n);
+        else
+            snprintf(buf, sizeof(buf), "Frame %d (%.1f ms)###FrameStats%d", n, (float)(BenchRand(&seed) % 1000) * 0.1f, n % 4);
+        out_labels->push_back(buf);
+    }
+}
+
+static void Micro_Hash(BenchMicroResult* result)
+{
+    // Check "###" semantics first
+    if (ImHashStr("Hello###World") != ImHashStr("###World") || ImHashStr("a####b") != ImHashStr("###b") || ImHashStr("abc###") != ImHashStr("###") ||
+        ImHashStr("Hello###World", 13) != ImHashStr("###World") || ImHashStr("Hello##World") == ImHashStr("##World") || ImHashStr("abc", 2) != ImHashStr("ab"))
+    {
+        fprintf(stderr, "ImHashStr(): incorrect handling of the ### operator!\n");
+        exit(1);
+    }
+
+    const int LABELS_COUNT = 4096;
+    std::vector<std::string> labels;
+    BuildLabelCorpus(&labels, LABELS_COUNT);
+    size_t total_len = 0;
+    for (size_t n = 0; n < labels.size(); n++)
+        total_len += labels[n].size();
+
+    // Count collisions amongst distinct labels, using the same seed (same parent ID)
+    std::vector<std::string> unique_labels = labels;
+    std::sort(unique_labels.begin(), unique_labels.end());
+    unique_labels.erase(std::unique(unique_labels.begin(), unique_labels.end()), unique_labels.end());
+    std::vector<ImGuiID> unique_ids;
+    for (size_t n = 0; n < unique_labels.size(); n++)
+        if (unique_labels[n].find("###") == std::string::npos) // Different labels sharing a "###id" suffix are expected to collide
+            unique_ids.push_back(ImHashStr(unique_labels[n].c_str(), 0, 0x12345678));
+    const size_t unique_ids_count = unique_ids.size();
+    std::sort(unique_ids.begin(), unique_ids.end());
+    unique_ids.erase(std::unique(unique_ids.begin(), unique_ids.end()), unique_ids.end());
+
+    volatile ImGuiID sink = 0;
+    ImGuiID id = 0;
+    const double str_ids_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < LABELS_COUNT; n++) id = ImHashStr(labels[n].c_str(), 0, id); sink = id; }, LABELS_COUNT);
+    const double str_len_ids_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < LABELS_COUNT; n++) id = ImHashStr(labels[n].c_str(), labels[n].size(), id); sink = id; }, LABELS_COUNT);
+    const double int_ids_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < LABELS_COUNT; n++) id = ImHashData(&n, sizeof(n), id); sink = id; }, LABELS_COUNT);
+    const double ptr_ids_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < LABELS_COUNT; n++) { const void* ptr = &labels[n]; id = ImHashData(&ptr, sizeof(ptr), id); } sink = id; }, LABELS_COUNT);
+    (void)sink;
+
+    result->Add("avg_label_len", (double)total_len / LABELS_COUNT);
+    result->Add("str_ids_per_sec", str_ids_per_sec);
+    result->Add("str_mbytes_per_sec", str_ids_per_sec * ((double)total_len / LABELS_COUNT) / (1024.0 * 1024.0));
+    result->Add("str_len_ids_per_sec", str_len_ids_per_sec);
+    result->Add("int_ids_per_sec", int_ids_per_sec);
+    result->Add("ptr_ids_per_sec", ptr_ids_per_sec);
+    result->Add("collisions", (double)(unique_ids_count - unique_ids.size()));
+}
+
+// Insert N keys in random order (e.g. many tree nodes appearing on the same frame), then query them.
+static void Micro_Storage(BenchMicroResult* result)
+{
+    static const int    keys_counts[] = { 1000, 10000, 100000 };
+    static const char*  insert_names[] = { "insert_1k_ms", "insert_10k_ms", "insert_100k_ms" };
+    static const char*  lookup_names[] = { "lookup_1k_ns", "lookup_10k_ns", "lookup_100k_ns" };
+    static const char*  bytes_names[] = { "bytes_1k", "bytes_10k", "bytes_100k" };
+    for (int count_n = 0; count_n < IM_ARRAYSIZE(keys_counts); count_n++)
+    {
+        const int keys_count = keys_counts[count_n];
+        std::vector<ImGuiID> keys(keys_count);
+        for (int n = 0; n < keys_count; n++)
+            keys[n] = ImHashData(&n, sizeof(n), 0x12345678);
+
+        ImGuiStorage storage;
+        BenchClock::time_point t0 = BenchClock::now();
+        for (int n = 0; n < keys_count; n++)
+            *storage.GetIntRef(keys[n], -1) = n;
+        const double insert_ms = GetElapsedMs(t0);
+        for (int n = 0; n < keys_count; n++)
+            if (storage.GetInt(keys[n], -1) != n)
+            {
+                fprintf(stderr, "ImGuiStorage: lookup failure for key 0x%08X!\n", keys[n]);
+                exit(1);
+            }
+
+        volatile unsigned int sink = 0;
+        const double lookups_per_sec = MeasureCallsPerSecond([&]() { unsigned int sum = 0; for (int n = 0; n < keys_count; n++) sum += (unsigned int)storage.GetInt(keys[n], 0); sink = sum; }, keys_count);
+        (void)sink;
+
+        result->Add(insert_names[count_n], insert_ms);
+        result->Add(lookup_names[count_n], 1e9 / lookups_per_sec);
+        result->Add(bytes_names[count_n], (double)storage.Data.size_in_bytes());
+    }
+}
+
+// Window lookups by name and by ID with 10k existing windows
+static void Micro_WindowLookup(BenchMicroResult* result)
+{
+    const int WINDOWS_COUNT = 10000;
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    std::vector<std::string> names;
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+    {
+        char name[32];
+        sprintf(name, "Window %05d", n);
+        names.push_back(name);
+    }
+    ImGui::NewFrame();
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+    {
+        ImGui::Begin(names[n].c_str());
+        ImGui::End();
+    }
+    ImGui::EndFrame();
+    std::vector<ImGuiID> ids;
+    for (int n = 0; n < WINDOWS_COUNT; n++)
+        ids.push_back(ImGui::FindWindowByName(names[n].c_str())->ID);
+
+    volatile ImGuiWindow* sink = NULL;
+    const double by_name_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < WINDOWS_COUNT; n++) sink = ImGui::FindWindowByName(names[n].c_str()); }, WINDOWS_COUNT);
+    const double by_id_per_sec = MeasureCallsPerSecond([&]() { for (int n = 0; n < WINDOWS_COUNT; n++) sink = ImGui::FindWindowByID(ids[n]); }, WINDOWS_COUNT);
+    (void)sink;
+    ImGui::DestroyContext();
+
+    result->Add("find_by_name_ns", 1e9 / by_name_per_sec);
+    result->Add("find_by_id_ns", 1e9 / by_id_per_sec);
+}
+
+// Find the window under the mouse with 100/1k/10k overlapping windows: linear scan of g.Windows vs the grid built by EndFrame().
+// Also hit-test a custom canvas of 100k items with ImRectGrid.
+static void Micro_WindowHover(BenchMicroResult* result)
+{
+    static const char*  linear_names[] = { "hover_100_linear_ns", "hover_1k_linear_ns", "hover_10k_linear_ns" };
+    static const char*  grid_names[] = { "hover_100_grid_ns", "hover_1k_grid_ns", "hover_10k_grid_ns" };
+    const int windows_counts[] = { 100, 1000, 10000 };
+    const int MOUSE_POSITIONS_COUNT = 256;
+    for (int variant = 0; variant < IM_ARRAYSIZE(windows_counts); variant++)
+    {
+        ImGui::CreateContext();
+        ImGuiContext& g = *ImGui::GetCurrentContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = NULL;
+        io.DisplaySize = ImVec2(1920, 1080);
+        unsigned char* tex_pixels = NULL;
+        int tex_w, tex_h;
+        io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+        std::vector<std::string> names;
+        unsigned int seed = 13;
+        for (int n = 0; n < windows_counts[variant]; n++)
+        {
+            char name[32];
+            sprintf(name, "Window %05d", n);
+            names.push_back(name);
+        }
+        for (int frame = 0; frame < 2; frame++)
+        {
+            ImGui::NewFrame();
+            for (int n = 0; n < windows_counts[variant]; n++)
+            {
+                ImGui::SetNextWindowPos(ImVec2((float)(BenchRand(&seed) % 1800), (float)(BenchRand(&seed) % 1000)), ImGuiCond_Once);
+                ImGui::SetNextWindowSize(ImVec2(60.0f + BenchRand(&seed) % 200, 40.0f + BenchRand(&seed) % 150), ImGuiCond_Once);
+                ImGui::Begin(names[n].c_str(), NULL, ImGuiWindowFlags_NoSavedSettings);
+                ImGui::End();
+            }
+            ImGui::EndFrame();
+        }
+        ImVec2 mouse_positions[MOUSE_POSITIONS_COUNT];
+        for (int n = 0; n < MOUSE_POSITIONS_COUNT; n++)
+            mouse_positions[n] = ImVec2((float)(BenchRand(&seed) % 1920), (float)(BenchRand(&seed) % 1080));
+
+        // UpdateHoveredWindowAndCaptureFlags() uses the grid until something invalidates it
+        ImGuiWindow* hovered_windows[MOUSE_POSITIONS_COUNT];
+        const double grid_per_sec = MeasureCallsPerSecond([&]()
+        {
+            for (int n = 0; n < MOUSE_POSITIONS_COUNT; n++)
+            {
+                io.MousePos = mouse_positions[n];
+                ImGui::UpdateHoveredWindowAndCaptureFlags();
+                hovered_windows[n] = g.HoveredWindow;
+            }
+        }, MOUSE_POSITIONS_COUNT);
+        IM_ASSERT(g.WindowsHitGridValid);
+        g.WindowsHitGridValid = false;
+        const double linear_per_sec = MeasureCallsPerSecond([&]()
+        {
+            for (int n = 0; n < MOUSE_POSITIONS_COUNT; n++)
+            {
+                io.MousePos = mouse_positions[n];
+                ImGui::UpdateHoveredWindowAndCaptureFlags();
+                IM_ASSERT(g.HoveredWindow == hovered_windows[n]);
+            }
+        }, MOUSE_POSITIONS_COUNT);
+        ImGui::DestroyContext();
+
+        result->Add(linear_names[variant], 1e9 / linear_per_sec);
+        result->Add(grid_names[variant], 1e9 / grid_per_sec);
+    }
+
+    // Custom canvas: 100k items (e.g. nodes, map markers) hit-tested against the mouse position
+    const int ITEMS_COUNT = 100000;
+    ImRectGrid grid;
+    unsigned int seed = 17;
+    for (int n = 0; n < ITEMS_COUNT; n++)
+    {
+        const float x = (float)(BenchRand(&seed) % 20000);
+        const float y = (float)(BenchRand(&seed) % 20000);
+        grid.Add(ImRect(x, y, x + 10.0f + BenchRand(&seed) % 50, y + 10.0f + BenchRand(&seed) % 50));
+    }
+    const double build_per_sec = MeasureCallsPerSecond([&]() { grid.Build(); }, 1);
+    volatile int sink = 0;
+    const double query_per_sec = MeasureCallsPerSecond([&]()
+    {
+        for (int n = 0; n < 1000; n++)
+            sink = grid.FindFrontMost(ImVec2((float)(BenchRand(&seed) % 20000), (float)(BenchRand(&seed) % 20000)));
+    }, 1000);
+    (void)sink;
+    result->Add("canvas_100k_build_ms", 1e3 / build_per_sec);
+    result->Add("canvas_100k_query_ns", 1e9 / query_per_sec);
+}
+
+// Anti-aliased polylines (e.g. line graphs, node editor wires), reporting points tessellated per second.
+// The checksum of the generated vertices/indices allows comparing the output of builds with and without IMGUI_DISABLE_SIMD.
+static void Micro_Polyline(BenchMicroResult* result)
+{
+    const int POINTS_COUNT = 1000;
+    const int LINES_PER_BATCH = 10;     // 40k vertices at most, to stay within 16-bit indices
+    std::vector<ImVec2> points(POINTS_COUNT);
+    unsigned int seed = 4;
+    for (int n = 0; n < POINTS_COUNT; n++)
+        points[n] = ImVec2(n * 1.5f, 500.0f + sinf(n * 0.05f) * 200.0f + (float)(BenchRand(&seed) % 100) * 0.25f);
+
+    ImDrawListSharedData shared_data;
+    shared_data.InitialFlags = ImDrawListFlags_AntiAliasedLines;
+    ImDrawList draw_list(&shared_data);
+
+    static const char*  names[] = { "thin_open_points_per_sec", "thin_closed_points_per_sec", "thick_open_points_per_sec", "thick_closed_points_per_sec" };
+    ImGuiID checksum = 0;
+    for (int variant = 0; variant < IM_ARRAYSIZE(names); variant++)
+    {
+        const float thickness = (variant >= 2) ? 3.0f : 1.0f;
+        const bool closed = (variant & 1) != 0;
+        const double lines_per_sec = MeasureCallsPerSecond([&]()
+        {
+            draw_list.Clear();
+            draw_list.AddDrawCmd();
+            for (int n = 0; n < LINES_PER_BATCH; n++)
+                draw_list.AddPolyline(points.data(), POINTS_COUNT, IM_COL32(255, 255, 0, 255), closed, thickness);
+        }, LINES_PER_BATCH);
+        checksum = ImHashData(draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.size_in_bytes(), checksum);
+        checksum = ImHashData(draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.size_in_bytes(), checksum);
+        result->Add(names[variant], lines_per_sec * POINTS_COUNT);
+    }
+    result->Add("checksum", (double)checksum);
+}
+
+static void Micro_PolylineStrided(BenchMicroResult* result)
+{
+    const int SAMPLES_COUNT = 1000000;
+    std::vector<ImVec2> samples(SAMPLES_COUNT);
+    unsigned int seed = 8;
+    for (int n = 0; n < SAMPLES_COUNT; n++)
+        samples[n] = ImVec2((float)n, sinf(n * 0.0001f) + (float)(BenchRand(&seed) % 1000) * 0.0002f);
+
+    ImDrawListSharedData shared_data;
+    shared_data.InitialFlags = ImDrawListFlags_AntiAliasedLines;
+    ImDrawList draw_list(&shared_data);
+
+    // Fit the whole trace in 1280 pixels, then zoom on 1/10th of it
+    static const char*  names[] = { "xy_samples_per_sec", "y_samples_per_sec", "y_zoomed_samples_per_sec" };
+    ImGuiID checksum = 0;
+    for (int variant = 0; variant < IM_ARRAYSIZE(names); variant++)
+    {
+        const float zoom = (variant == 2) ? 10.0f : 1.0f;
+        const ImVec2 scale(1280.0f * zoom / SAMPLES_COUNT, -300.0f);
+        const ImVec2 offset(0.0f, 360.0f);
+        const float* xs = (variant == 0) ? &samples[0].x : NULL;
+        const double calls_per_sec = MeasureCallsPerSecond([&]()
+        {
+            draw_list.Clear();
+            draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1280.0f, 720.0f));
+            draw_list.AddPolylineStrided(xs, &samples[0].y, SAMPLES_COUNT, sizeof(ImVec2), offset, scale, IM_COL32(255, 255, 0, 255), 1.0f);
+            draw_list.PopClipRect();
+        }, 1);
+        checksum = ImHashData(draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.size_in_bytes(), checksum);
+        checksum = ImHashData(draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.size_in_bytes(), checksum);
+        result->Add(names[variant], calls_per_sec * SAMPLES_COUNT);
+        if (variant == 0)
+            result->Add("vertices", (double)draw_list.VtxBuffer.Size);
+    }
+    result->Add("checksum", (double)checksum);
+}
+
+// Typical primitives (shapes, anti-aliased lines, text, images with sub-range UV) at fractional positions, reporting vertices output per second.
+// The checksum hashes every vertex converted to the IMGUI_USE_COMPACT_DRAWVERT encoding (a no-op when it is enabled), so builds with and
+// without IMGUI_USE_COMPACT_DRAWVERT need to report the same value. 'max_pos_error_px' is the largest rounding error of the compact encoding.
+static void Micro_DrawVert(BenchMicroResult* result)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImFont* font = io.Fonts->Fonts[0];
+
+    ImDrawListSharedData shared_data = *ImGui::GetDrawListSharedData();
+    shared_data.InitialFlags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+    ImDrawList draw_list(&shared_data);
+    const double calls_per_sec = MeasureCallsPerSecond([&]()
+    {
+        draw_list.Clear();
+        draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1920.0f, 1080.0f));
+        draw_list.PushTextureID(io.Fonts->TexID);
+        for (int n = 0; n < 100; n++)
+        {
+            const ImVec2 p((n % 10) * 190.0f + n * 0.137f, (n / 10) * 105.0f + n * 0.291f);
+            draw_list.AddRectFilled(p, ImVec2(p.x + 180.0f, p.y + 100.0f), IM_COL32(40, 40, 40, 255), 4.0f);
+            draw_list.AddRect(p, ImVec2(p.x + 180.0f, p.y + 100.0f), IM_COL32(200, 200, 200, 255), 4.0f, ImDrawCornerFlags_All, 1.5f);
+            draw_list.AddCircleFilled(ImVec2(p.x + 20.0f, p.y + 20.0f), 10.5f, IM_COL32(255, 0, 0, 200));
+            draw_list.AddBezierCurve(ImVec2(p.x + 40.0f, p.y + 90.0f), ImVec2(p.x + 80.0f, p.y + 10.0f), ImVec2(p.x + 120.0f, p.y + 90.0f), ImVec2(p.x + 170.0f, p.y + 30.0f), IM_COL32(0, 255, 0, 255), 2.0f);
+            draw_list.AddImage(io.Fonts->TexID, ImVec2(p.x + 140.0f, p.y + 5.0f), ImVec2(p.x + 175.0f, p.y + 40.0f), ImVec2(0.25f, 0.125f), ImVec2(0.75f, 0.625f));
+            font->RenderText(&draw_list, font->FontSize, ImVec2(p.x + 5.0f, p.y + 45.0f), IM_COL32_WHITE, draw_list._ClipRectStack.back(), "Hello, world! 0123456789", NULL);
+        }
+        draw_list.PopTextureID();
+        draw_list.PopClipRect();
+    }, 1);
+
+    ImGuiID checksum = ImHashData(draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.size_in_bytes());
+    float max_pos_error = 0.0f;
+    for (int n = 0; n < draw_list.VtxBuffer.Size; n++)
+    {
+        const ImDrawVert& vtx = draw_list.VtxBuffer[n];
+        struct { ImDrawVertPos16 pos; ImDrawVertUV16 uv; ImU32 col; } compact_vtx;
+        compact_vtx.pos = ImVec2(vtx.pos);
+        compact_vtx.uv = ImVec2(vtx.uv);
+        compact_vtx.col = vtx.col;
+        checksum = ImHashData(&compact_vtx, sizeof(compact_vtx), checksum);
+        const ImVec2 pos = vtx.pos, compact_pos = compact_vtx.pos;
+        max_pos_error = ImMax(max_pos_error, ImMax(ImFabs(compact_pos.x - pos.x), ImFabs(compact_pos.y - pos.y)));
+    }
+    IM_ASSERT(max_pos_error <= 0.5f / IMGUI_COMPACT_DRAWVERT_POS_SCALE);
+    result->Add("vertices_per_sec", calls_per_sec * draw_list.VtxBuffer.Size);
+    result->Add("vertices_bytes", (double)draw_list.VtxBuffer.size_in_bytes());
+    result->Add("max_pos_error_px", (double)max_pos_error);
+    result->Add("checksum", (double)checksum);
+    ImGui::DestroyContext();
+}
+
+// Render 100 different 64 bytes strings, ASCII or 2-bytes UTF-8 sequences, with and without io.ConfigTextCacheBudget
+static void Micro_TextCache(BenchMicroResult* result)
+{
+    const int STRINGS_COUNT = 100;
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImFont* font = io.Fonts->Fonts[0];
+
+    static const char*  names[] = { "ascii_calls_per_sec", "ascii_cached_calls_per_sec", "utf8_calls_per_sec", "utf8_cached_calls_per_sec" };
+    for (int variant = 0; variant < IM_ARRAYSIZE(names); variant++)
+    {
+        const bool utf8 = (variant >= 2);
+        std::vector<std::string> strings;
+        for (int n = 0; n < STRINGS_COUNT; n++)
+        {
+            char buf[80];
+            int len = sprintf(buf, "%03d ", n);
+            for (int c = 0; len < 64; c++)
+                len += utf8 ? sprintf(buf + len, "\xC3%c", 0xA0 + (c % 16)) : sprintf(buf + len, "%c", 'a' + (c % 26));
+            strings.push_back(buf);
+        }
+
+        ImFontTextCache text_cache;
+        ImDrawListSharedData shared_data = *ImGui::GetDrawListSharedData();
+        shared_data.TextCache = (variant & 1) ? &text_cache : NULL;
+        ImDrawList draw_list(&shared_data);
+        const double calls_per_sec = MeasureCallsPerSecond([&]()
+        {
+            text_cache.GarbageCollect(1024 * 1024);
+            draw_list.Clear();
+            draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1280.0f, 720.0f));
+            for (int n = 0; n < STRINGS_COUNT; n++)
+                font->RenderText(&draw_list, font->FontSize, ImVec2(10.0f, 10.0f + n * 7.0f), IM_COL32_WHITE, draw_list._ClipRectStack.back(), strings[n].c_str(), strings[n].c_str() + strings[n].size());
+            draw_list.PopClipRect();
+        }, STRINGS_COUNT);
+        result->Add(names[variant], calls_per_sec);
+    }
+    ImGui::DestroyContext();
+}
+
+// Measure/render ~200 KB of multi-line text: ASCII log lines, Latin-1 (2-bytes UTF-8 sequences) and CJK (3-bytes UTF-8 sequences)
+static void Micro_TextThroughput(BenchMicroResult* result)
+{
+    const int LINES_COUNT = 2000;
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImFont* font = io.Fonts->Fonts[0];
+
+    std::string corpus[3];
+    unsigned int seed = 9;
+    for (int line_n = 0; line_n < LINES_COUNT; line_n++)
+    {
+        char buf[128];
+        sprintf(buf, "[%05d] %08X Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.\n", line_n, BenchRand(&seed));
+        corpus[0] += buf;
+        for (const char* p = buf; *p; p++)
+        {
+            if ((p - buf) % 5 == 3 && *p >= 'a' && *p <= 'z')
+                { corpus[1] += '\xC3'; corpus[1] += (char)(0xA0 + (*p - 'a') % 16); }
+            else
+                corpus[1] += *p;
+        }
+        for (int c = 0; c < 40; c++)
+        {
+            unsigned int cp = 0x4E00 + BenchRand(&seed) % 2000;
+            corpus[2] += (char)(0xE0 | (cp >> 12));
+            corpus[2] += (char)(0x80 | ((cp >> 6) & 0x3F));
+            corpus[2] += (char)(0x80 | (cp & 0x3F));
+        }
+        corpus[2] += '\n';
+    }
+
+    ImDrawListSharedData shared_data = *ImGui::GetDrawListSharedData();
+    ImDrawList draw_list(&shared_data);
+    static const char*  calc_names[] = { "ascii_calc_mb_per_sec", "latin1_calc_mb_per_sec", "cjk_calc_mb_per_sec" };
+    static const char*  render_names[] = { "ascii_render_mb_per_sec", "latin1_render_mb_per_sec", "cjk_render_mb_per_sec" };
+    for (int variant = 0; variant < IM_ARRAYSIZE(calc_names); variant++)
+    {
+        const char* text_begin = corpus[variant].c_str();
+        const char* text_end = text_begin + corpus[variant].size();
+        const double mb = (double)corpus[variant].size() / (1024.0 * 1024.0);
+        ImVec2 text_size;
+        const double calc_per_sec = MeasureCallsPerSecond([&]() { text_size = font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, text_begin, text_end); }, 1);
+        const double render_per_sec = MeasureCallsPerSecond([&]()
+        {
+            draw_list.Clear();
+            draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1e6f, 1e6f));
+            draw_list.PushTextureID(io.Fonts->TexID);
+            font->RenderText(&draw_list, font->FontSize, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, draw_list._ClipRectStack.back(), text_begin, text_end);
+        }, 1);
+        result->Add(calc_names[variant], calc_per_sec * mb);
+        result->Add(render_names[variant], render_per_sec * mb);
+        IM_ASSERT(text_size.x > 0.0f);
+    }
+    ImGui::DestroyContext();
+}
+
+// Edit a large document with InputTextMultiline(): frame time while idle, typing a character and moving the cursor, for 1 MB and 5 MB of text.
+static void Micro_InputTextLarge(BenchMicroResult* result)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.KeyMap[ImGuiKey_DownArrow] = 1;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    static const char*  idle_names[] = { "1mb_idle_ms", "5mb_idle_ms" };
+    static const char*  char_names[] = { "1mb_char_ms", "5mb_char_ms" };
+    static const char*  down_names[] = { "1mb_down_ms", "5mb_down_ms" };
+    const int doc_sizes[] = { 1 << 20, 5 << 20 };
+    for (int variant = 0; variant < IM_ARRAYSIZE(doc_sizes); variant++)
+    {
+        std::vector<char> buf;
+        unsigned int seed = 11;
+        for (int line_n = 0; (int)buf.size() < doc_sizes[variant]; line_n++)
+        {
+            char line[128];
+            int line_len = sprintf(line, "%d key_%u = \"value with some text\"\n", line_n, BenchRand(&seed) % 1000);
+            buf.insert(buf.end(), line, line + line_len);
+        }
+        buf.push_back(0);
+        buf.resize(buf.size() * 2, 0);
+
+        // Activate the widget and move the cursor to the middle of the document
+        ImGui::ClearActiveID();
+        double frame_ms = 0.0;
+        auto frame = [&]()
+        {
+            BenchClock::time_point t0 = BenchClock::now();
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0, 0));
+            ImGui::SetNextWindowSize(ImVec2(900, 700));
+            ImGui::Begin("Editor");
+            ImGui::InputTextMultiline("##doc", buf.data(), buf.size(), ImVec2(850, 600));
+            ImGui::End();
+            ImGui::Render();
+            frame_ms = GetElapsedMs(t0);
+            io.MouseDown[0] = false;
+            io.KeysDown[1] = false;
+        };
+        frame();
+        io.MousePos = ImVec2(200, 100);
+        io.MouseDown[0] = true;
+        frame();
+        frame();
+        ImGuiInputTextState* state = ImGui::GetInputTextState(ImGui::GetActiveID());
+        IM_ASSERT(state != NULL);
+        state->Stb.cursor = state->Stb.select_start = state->Stb.select_end = state->CurLenW / 2;
+        state->CursorFollow = true;
+        frame();
+
+        double best_ms[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        for (int iter = 0; iter < 10; iter++)
+        {
+            frame();
+            best_ms[0] = ImMin(best_ms[0], frame_ms);
+            io.AddInputCharacter('x');
+            frame();
+            best_ms[1] = ImMin(best_ms[1], frame_ms);
+            io.KeysDown[1] = true;
+            frame();
+            best_ms[2] = ImMin(best_ms[2], frame_ms);
+            frame();
+        }
+        result->Add(idle_names[variant], best_ms[0]);
+        result->Add(char_names[variant], best_ms[1]);
+        result->Add(down_names[variant], best_ms[2]);
+    }
+    ImGui::DestroyContext();
+}
+
+// Vertex generation of the ColorPicker4() hue wheel (200 pixels wide), in place and copied from the cached mesh, in hue wheels per second.
+// Both outputs are compared: indices and colors must match and 'max_pos_error_px' is the largest difference of positions (float rounding).
+// 'pickers_ms_per_frame' is the frame time of a window with 24 hue wheel pickers.
+static void Micro_ColorPicker(BenchMicroResult* result)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImGui::NewFrame();
+
+    static const char*  names[] = { "wheels_per_sec", "cached_wheels_per_sec" };
+    ImDrawListSharedData shared_data = *ImGui::GetDrawListSharedData();
+    shared_data.InitialFlags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill;
+    ImDrawList draw_lists[2] = { ImDrawList(&shared_data), ImDrawList(&shared_data) };
+    for (int variant = 0; variant < 2; variant++)
+    {
+        ImDrawList& draw_list = draw_lists[variant];
+        const double calls_per_sec = MeasureCallsPerSecond([&]()
+        {
+            draw_list.Clear();
+            draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1920.0f, 1080.0f));
+            for (int n = 0; n < 10; n++)
+                ImGui::RenderColorPickerHueWheel(&draw_list, ImVec2(110.5f + n * 200.0f, 300.25f), 84.0f, 100.0f, (n & 1) ? 1.0f : 0.6f, variant == 1);
+            draw_list.PopClipRect();
+        }, 10);
+        result->Add(names[variant], calls_per_sec);
+    }
+
+    IM_ASSERT(draw_lists[0].VtxBuffer.Size == draw_lists[1].VtxBuffer.Size && draw_lists[0].IdxBuffer.Size == draw_lists[1].IdxBuffer.Size);
+    IM_ASSERT(memcmp(draw_lists[0].IdxBuffer.Data, draw_lists[1].IdxBuffer.Data, (size_t)draw_lists[0].IdxBuffer.size_in_bytes()) == 0);
+    float max_pos_error = 0.0f;
+    for (int n = 0; n < draw_lists[0].VtxBuffer.Size; n++)
+    {
+        const ImDrawVert& vtx0 = draw_lists[0].VtxBuffer[n];
+        const ImDrawVert& vtx1 = draw_lists[1].VtxBuffer[n];
+        IM_ASSERT(vtx0.col == vtx1.col);
+        const ImVec2 pos0 = vtx0.pos, pos1 = vtx1.pos;
+        max_pos_error = ImMax(max_pos_error, ImMax(ImFabs(pos0.x - pos1.x), ImFabs(pos0.y - pos1.y)));
+    }
+    result->Add("vertices_per_wheel", draw_lists[0].VtxBuffer.Size / 10.0);
+    result->Add("max_pos_error_px", (double)max_pos_error);
+    ImGui::EndFrame();
+
+    float colors[24][4];
+    for (int n = 0; n < 24; n++)
+        ImGui::ColorConvertHSVtoRGB(n / 24.0f, 0.7f, 0.8f, colors[n][0], colors[n][1], colors[n][2]);
+    double total_ms = 0.0;
+    const int frames_count = 100;
+    for (int frame_n = 0; frame_n < frames_count + 1; frame_n++)
+    {
+        BenchClock::time_point t0 = BenchClock::now();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Material", NULL, ImGuiWindowFlags_NoTitleBar);
+        for (int n = 0; n < 24; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::SetNextItemWidth(300.0f);
+            ImGui::ColorPicker3("##picker", colors[n], ImGuiColorEditFlags_PickerHueWheel | ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_NoSidePreview);
+            ImGui::PopID();
+            if ((n % 6) != 5)
+                ImGui::SameLine();
+        }
+        ImGui::End();
+        ImGui::Render();
+        if (frame_n > 0)
+            total_ms += GetElapsedMs(t0);
+    }
+    result->Add("pickers_ms_per_frame", total_ms / frames_count);
+    ImGui::DestroyContext();
+}
+
+// Draw list buffers capacity, without/with io.ConfigDrawListsShrinkFrames and io.ConfigDrawListsPreSize:
+// - 'spike': one frame of 250k rectangles (1M vertices) followed by 600 frames of 1000 rectangles, reporting the final capacity.
+// - 'ramp': 300 frames adding 20 more rectangles each frame, reporting the number of frames which had to grow buffers while adding primitives.
+static void Micro_DrawListCapacity(BenchMicroResult* result)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    static const char*  spike_names[] = { "spike_kb", "spike_shrink_kb" };
+    static const char*  ramp_names[] = { "ramp_regrowing_frames", "ramp_presize_regrowing_frames" };
+    static const char*  ramp_ms_names[] = { "ramp_ms_per_frame", "ramp_presize_ms_per_frame" };
+    for (int variant = 0; variant < 2; variant++)
+    {
+        ImDrawListSharedData shared_data = *ImGui::GetDrawListSharedData();
+        shared_data.InitialFlags = ImDrawListFlags_AllowVtxOffset;
+        shared_data.BuffersShrinkFrames = variant ? 300 : 0;
+        shared_data.BuffersPreSize = variant ? true : false;
+        auto draw_rects = [](ImDrawList* draw_list, int count)
+        {
+            draw_list->PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(1920.0f, 1080.0f));
+            draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+            for (int n = 0; n < count; n++)
+                draw_list->AddRectFilled(ImVec2((float)(n % 1900), (float)(n / 1900 % 1000)), ImVec2((float)(n % 1900) + 10.0f, (float)(n / 1900 % 1000) + 10.0f), IM_COL32_WHITE);
+            draw_list->PopTextureID();
+            draw_list->PopClipRect();
+        };
+
+        ImDrawList spike_draw_list(&shared_data);
+        for (int frame_n = 0; frame_n < 601; frame_n++)
+        {
+            spike_draw_list.Clear();
+            draw_rects(&spike_draw_list, frame_n == 0 ? 250000 : 1000);
+        }
+        result->Add(spike_names[variant], (double)(spike_draw_list.VtxBuffer.Capacity * (int)sizeof(ImDrawVert) + spike_draw_list.IdxBuffer.Capacity * (int)sizeof(ImDrawIdx)) / 1024);
+
+        ImDrawList ramp_draw_list(&shared_data);
+        int regrowing_frames = 0;
+        double total_ms = 0.0;
+        for (int frame_n = 0; frame_n < 300; frame_n++)
+        {
+            BenchClock::time_point t0 = BenchClock::now();
+            ramp_draw_list.Clear();
+            const int vtx_capacity = ramp_draw_list.VtxBuffer.Capacity;
+            draw_rects(&ramp_draw_list, 1000 + frame_n * 20);
+            total_ms += GetElapsedMs(t0);
+            if (ramp_draw_list.VtxBuffer.Capacity != vtx_capacity)
+                regrowing_frames++;
+        }
+        result->Add(ramp_names[variant], regrowing_frames);
+        result->Add(ramp_ms_names[variant], total_ms / 300);
+    }
+    ImGui::DestroyContext();
+}
+
+// Cycle through 64 windows of 400-2000 rectangles, 4 visible at a time, plus a window whose contents shrink after 100 frames.
+// Compare memory of windows transient buffers, frame time and allocations without/with io.ConfigMemoryCompactBudget, once all windows
+// have been created and the first window has shrunk (last 300 frames).
+static void Micro_MemoryBudget(BenchMicroResult* result)
+{
+    const int WINDOWS_COUNT = 64;
+    const int FRAMES_COUNT = 600;
+    const int MEASURED_FRAMES_COUNT = 300;
+    static const char*  peak_names[] = { "unlimited_peak_kb", "budget_peak_kb" };
+    static const char*  frame_names[] = { "unlimited_ms_per_frame", "budget_ms_per_frame" };
+    static const char*  alloc_names[] = { "unlimited_allocs_per_frame", "budget_allocs_per_frame" };
+    const int budgets[] = { 0, 1024 * 1024 };
+    for (int variant = 0; variant < IM_ARRAYSIZE(budgets); variant++)
+    {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = NULL;
+        io.DisplaySize = ImVec2(1280, 720);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        io.ConfigWindowsMemoryCompactTimer = -1.0f;
+        io.ConfigMemoryCompactBudget = budgets[variant];
+        unsigned char* tex_pixels = NULL;
+        int tex_w, tex_h;
+        io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+        size_t peak_size = 0;
+        long long allocs = 0;
+        double total_ms = 0.0;
+        for (int frame_n = 0; frame_n < FRAMES_COUNT; frame_n++)
+        {
+            const bool measure = (frame_n >= FRAMES_COUNT - MEASURED_FRAMES_COUNT);
+            BenchClock::time_point t0 = BenchClock::now();
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(900, 0));
+            ImGui::SetNextWindowSize(ImVec2(300, 700));
+            ImGui::Begin("Main");
+            for (int rect_n = 0; rect_n < (frame_n < 100 ? 20000 : 200); rect_n++)
+                ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(900.0f + rect_n % 300, 20.0f), ImVec2(910.0f + rect_n % 300, 30.0f), IM_COL32_WHITE);
+            ImGui::End();
+            for (int n = 0; n < 4; n++)
+            {
+                const int window_n = (frame_n / 4 + n) % WINDOWS_COUNT;
+                char name[32];
+                sprintf(name, "Window %02d", window_n);
+                ImGui::SetNextWindowPos(ImVec2(n * 220.0f, 0.0f));
+                ImGui::SetNextWindowSize(ImVec2(200, 700));
+                ImGui::Begin(name);
+                for (int rect_n = 0; rect_n < 400 + (window_n * 37 % 400) * 4; rect_n++)
+                    ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(n * 220.0f, 20.0f + rect_n % 600), ImVec2(n * 220.0f + 10.0f, 30.0f + rect_n % 600), IM_COL32_WHITE);
+                ImGui::End();
+            }
+            ImGui::Render();
+            if (!measure)
+                continue;
+            total_ms += GetElapsedMs(t0);
+            allocs += io.MetricsFrameAllocations;
+
+            ImGuiContext& g = *GImGui;
+            size_t size = 0;
+            for (int n = 0; n < g.Windows.Size; n++)
+                if (!g.Windows[n]->MemoryCompacted)
+                    size += ImGui::GcCalcTransientWindowBuffersSize(g.Windows[n]);
+            peak_size = ImMax(peak_size, size);
+        }
+        result->Add(peak_names[variant], (double)(peak_size / 1024));
+        result->Add(frame_names[variant], total_ms / MEASURED_FRAMES_COUNT);
+        result->Add(alloc_names[variant], (double)allocs / MEASURED_FRAMES_COUNT);
+        if (budgets[variant] > 0)
+            result->Add("budget_reclaimed_kb", (double)(GImGui->GcReclaimedBytes / 1024));
+        ImGui::DestroyContext();
+    }
+}
+
+struct BenchMicro
+{
+    const char* Name;
+    const char* Desc;
+    void        (*Run)(BenchMicroResult* result);
+};
+
+static const BenchMicro g_Micros[] =
+{
+    { "hash",             "ImHashStr()/ImHashData() on a typical distribution of labels",                 Micro_Hash },
+    { "storage",          "ImGuiStorage insertion and queries with 1k/10k/100k keys",                     Micro_Storage },
+    { "window_lookup",    "FindWindowByName()/FindWindowByID() with 10k windows",                         Micro_WindowLookup },
+    { "window_hover",     "Hovered window with 100/1k/10k windows, ImRectGrid with 100k items",          Micro_WindowHover },
+    { "polyline",         "Anti-aliased AddPolyline() of 1000 points, thin/thick, open/closed",           Micro_Polyline },
+    { "polyline_strided", "AddPolylineStrided() of 1M samples, with/without x values, fitted and zoomed", Micro_PolylineStrided },
+    { "drawvert",         "Vertices per second of shapes, text and images, compact ImDrawVert checksum", Micro_DrawVert },
+    { "text_cache",       "RenderText() of 64 bytes strings, with/without io.ConfigTextCacheBudget",      Micro_TextCache },
+    { "text_throughput",  "CalcTextSizeA()/RenderText() MB/s on ~200 KB of ASCII, Latin-1 and CJK text", Micro_TextThroughput },
+    { "input_text_large", "InputTextMultiline() frame time editing a 1 MB and 5 MB document",          Micro_InputTextLarge },
+    { "color_picker",     "ColorPicker4() hue wheel vertices per second, in place and from the cached mesh", Micro_ColorPicker },
+    { "drawlist_capacity", "Draw list capacity after a spike, regrowth during a ramp (io.ConfigDrawListsShrinkFrames/PreSize)", Micro_DrawListCapacity },
+    { "memory_budget",    "Peak windows memory, frame time and allocations with io.ConfigMemoryCompactBudget", Micro_MemoryBudget },
+};
+
+//-----------------------------------------------------------------------------
+// Runner
+//-----------------------------------------------------------------------------
+
+struct BenchResult
+{
+    const BenchWorkload*    Workload;
+    BenchPhaseStats         NewFrame, Submit, EndFrame, Render, Total;
+    int                     CmdListsCount;
+    int                     CmdCount;
+    int                     DrawCallsCount;
+    int                     VtxCount;
+    int                     IdxCount;
+    int                     MaxVtxCount;
+    int                     MaxIdxCount;
+    int                     WindowsCount;
+    int                     ActiveWindowsCount;
+    int                     TotalFrameAllocations;  // Heap allocations (MemAlloc calls) during measured frames, zero when buffers have reached their steady-state capacity
+    int                     MaxFrameAllocations;
+    int                     MaxFrameArenaBytes;
+    struct AllocSite { std::string Name; int Count; };
+    std::vector<AllocSite>  AllocSites;             // Call sites of the allocations during measured frames (with IMGUI_ENABLE_ALLOC_TRACKING)
+#ifdef IMGUI_ENABLE_PROFILER
+    struct ZoneStats { const char* Name; int Count; double TotalMs; };
+    std::vector<ZoneStats>  Zones;
+    bool                    ZonesRecording;
+#endif
+};
+
+#ifdef IMGUI_ENABLE_PROFILER
+static void ProfilerZoneCallback(const ImGuiProfilerZone* zone, void* user_data)
+{
+    BenchResult* result = (BenchResult*)user_data;
+    if (!result->ZonesRecording)
+        return;
+    size_t n = 0;
+    while (n < result->Zones.size() && result->Zones[n].Name != zone->Name)
+        n++;
+    if (n == result->Zones.size())
+    {
+        BenchResult::ZoneStats stats = { zone->Name, 0, 0.0 };
+        result->Zones.push_back(stats);
+    }
+    result->Zones[n].Count++;
+    result->Zones[n].TotalMs += (double)(zone->TicksEnd - zone->TicksBegin) * 1000.0 / (double)ImGui::ProfilerGetTicksPerSecond();
+}
+#endif
+
+static void RunWorkload(const BenchWorkload* workload, int frames, int warmup, bool defer_tessellation, BenchThreadPool* thread_pool, int text_cache_budget, bool draw_data_arena, bool merge_commands, bool cpu_clip, BenchResult* result)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;   // Allow large meshes with 16-bit indices, as most renderer back-ends do
+    io.ConfigDrawListsDeferTessellation = defer_tessellation;
+    io.ConfigTextCacheBudget = text_cache_budget;
+    if (draw_data_arena)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasDrawDataArena;
+    io.ConfigDrawDataMergeCommands = merge_commands;
+    io.ConfigDrawListsCpuClipRect = cpu_clip;
+    if (thread_pool)
+    {
+        io.ParallelForFn = BenchThreadPool::ParallelFor;
+        io.ParallelForUserData = thread_pool;
+    }
+
+    // Build atlas
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    result->Workload = workload;
+    result->MaxVtxCount = result->MaxIdxCount = 0;
+    result->TotalFrameAllocations = result->MaxFrameAllocations = result->MaxFrameArenaBytes = 0;
+#ifdef IMGUI_ENABLE_PROFILER
+    result->ZonesRecording = false;
+    ImGui::SetProfilerZoneCallback(ProfilerZoneCallback, result);
+#endif
+    for (int frame = 0; frame < warmup + frames; frame++)
+    {
+        const bool measure = (frame >= warmup);
+#ifdef IMGUI_ENABLE_PROFILER
+        result->ZonesRecording = measure;
+#endif
+        BenchClock::time_point t0 = BenchClock::now();
+        ImGui::NewFrame();
+        const double t_new_frame = GetElapsedMs(t0);
+
+        BenchClock::time_point t1 = BenchClock::now();
+        workload->Submit(frame);
+        const double t_submit = GetElapsedMs(t1);
+
+        BenchClock::time_point t2 = BenchClock::now();
+        ImGui::EndFrame();
+        const double t_end_frame = GetElapsedMs(t2);
+
+        BenchClock::time_point t3 = BenchClock::now();
+        ImGui::Render();
+        const double t_render = GetElapsedMs(t3);
+        const int frame_allocations = GImGui->FrameAllocationsCount;
+        const int frame_arena_bytes = (int)GImGui->FrameArena.FrameBytes;
+
+        if (!measure)
+            continue;
+        result->NewFrame.Add(t_new_frame);
+        result->Submit.Add(t_submit);
+        result->EndFrame.Add(t_end_frame);
+        result->Render.Add(t_render);
+        result->Total.Add(t_new_frame + t_submit + t_end_frame + t_render);
+
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        result->CmdListsCount = draw_data->CmdListsCount;
+        result->VtxCount = draw_data->TotalVtxCount;
+        result->IdxCount = draw_data->TotalIdxCount;
+        result->CmdCount = 0;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            result->CmdCount += draw_data->CmdLists[n]->CmdBuffer.Size;
+        result->DrawCallsCount = io.MetricsRenderDrawCalls;
+        result->MaxVtxCount = std::max(result->MaxVtxCount, draw_data->TotalVtxCount);
+        result->MaxIdxCount = std::max(result->MaxIdxCount, draw_data->TotalIdxCount);
+        result->WindowsCount = io.MetricsRenderWindows;
+        result->ActiveWindowsCount = io.MetricsActiveWindows;
+        result->TotalFrameAllocations += frame_allocations;
+        result->MaxFrameAllocations = std::max(result->MaxFrameAllocations, frame_allocations);
+        result->MaxFrameArenaBytes = std::max(result->MaxFrameArenaBytes, frame_arena_bytes);
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+        for (int site_n = 0; site_n < GImGui->AllocSitesCount && frame_allocations > 0; site_n++)
+        {
+            const ImGuiAllocSite& site = GImGui->AllocSites[site_n];
+            if (site.CountThisFrame == 0)
+                continue;
+            char name[256];
+            if (site.Line > 0)
+                snprintf(name, sizeof(name), "%s(%d)", site.Name, site.Line);
+            else
+                snprintf(name, sizeof(name), "%s", site.Name);
+            size_t n = 0;
+            while (n < result->AllocSites.size() && result->AllocSites[n].Name != name)
+                n++;
+            if (n == result->AllocSites.size())
+                result->AllocSites.push_back(BenchResult::AllocSite { name, 0 });
+            result->AllocSites[n].Count += site.CountThisFrame;
+        }
+#endif
+
+        // Verify the arena contents once (outside of timings): the arena commands need to output the same triangles as the draw lists
+        if (draw_data_arena && frame == warmup)
+        {
+            IM_ASSERT(draw_data->ArenaCmdCount == result->CmdCount);
+            std::vector<ImDrawVert> lists_triangles, arena_triangles;
+            const ImDrawCmd* arena_cmd = draw_data->ArenaCmdBuffer;
+            for (int n = 0, vtx_offset = 0; n < draw_data->CmdListsCount; n++)
+            {
+                const ImDrawList* draw_list = draw_data->CmdLists[n];
+                IM_ASSERT(memcmp(draw_data->ArenaVtxBuffer + vtx_offset, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes()) == 0);
+                for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++, arena_cmd++)
+                {
+                    const ImDrawCmd* cmd = &draw_list->CmdBuffer[cmd_n];
+                    for (unsigned int elem_n = 0; elem_n < cmd->ElemCount; elem_n++)
+                        lists_triangles.push_back(draw_list->VtxBuffer[cmd->VtxOffset + draw_list->IdxBuffer[cmd->IdxOffset + elem_n]]);
+                    for (unsigned int elem_n = 0; elem_n < arena_cmd->ElemCount; elem_n++)
+                        arena_triangles.push_back(draw_data->ArenaVtxBuffer[arena_cmd->VtxOffset + draw_data->ArenaIdxBuffer[arena_cmd->IdxOffset + elem_n]]);
+                }
+                vtx_offset += draw_list->VtxBuffer.Size;
+            }
+            IM_ASSERT(lists_triangles.size() == arena_triangles.size());
+            IM_ASSERT(lists_triangles.empty() || memcmp(lists_triangles.data(), arena_triangles.data(), lists_triangles.size() * sizeof(ImDrawVert)) == 0);
+        }
+    }
+
+    ImGui::DestroyContext();
+}
+
+static void WritePhaseJson(FILE* f, const char* name, const BenchPhaseStats& stats, bool last)
+{
+    fprintf(f, "        \"%s\": { \"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"min_ms\": %.4f, \"max_ms\": %.4f }%s\n",
+        name, stats.Mean(), stats.Percentile(0.50), stats.Percentile(0.95), stats.Percentile(0.0), stats.Percentile(1.0), last ? "" : ",");
+}
+
+static void WriteResultsJson(FILE* f, const std::vector<BenchResult>& results, const std::vector<const BenchMicro*>& micros, const std::vector<BenchMicroResult>& micro_results, int frames, int warmup, bool defer_tessellation, int threads, int text_cache_budget, bool draw_data_arena, bool merge_commands, bool cpu_clip)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "  \"imgui_version\": \"%s\",\n", IMGUI_VERSION);
+    fprintf(f, "  \"imgui_version_num\": %d,\n", IMGUI_VERSION_NUM);
+    fprintf(f, "  \"hash_function\": \"%s\",\n", ImHashGetFunctionName());
+#ifdef IMGUI_USE_HASHED_STORAGE
+    fprintf(f, "  \"storage\": \"hashed\",\n");
+#else
+    fprintf(f, "  \"storage\": \"sorted\",\n");
+#endif
+#if defined(IMGUI_ENABLE_SSE)
+    fprintf(f, "  \"simd\": \"sse2\",\n");
+#elif defined(IMGUI_ENABLE_NEON)
+    fprintf(f, "  \"simd\": \"neon\",\n");
+#else
+    fprintf(f, "  \"simd\": \"none\",\n");
+#endif
+    fprintf(f, "  \"frames\": %d,\n", frames);
+    fprintf(f, "  \"warmup_frames\": %d,\n", warmup);
+    fprintf(f, "  \"defer_tessellation\": %s,\n", defer_tessellation ? "true" : "false");
+    fprintf(f, "  \"threads\": %d,\n", threads);
+    fprintf(f, "  \"text_cache_budget\": %d,\n", text_cache_budget);
+    fprintf(f, "  \"draw_data_arena\": %s,\n", draw_data_arena ? "true" : "false");
+    fprintf(f, "  \"merge_commands\": %s,\n", merge_commands ? "true" : "false");
+    fprintf(f, "  \"cpu_clip\": %s,\n", cpu_clip ? "true" : "false");
+    fprintf(f, "  \"workloads\": [\n");
+    for (size_t n = 0; n < results.size(); n++)
+    {
+        const BenchResult& r = results[n];
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"name\": \"%s\",\n", r.Workload->Name);
+        fprintf(f, "      \"phases\": {\n");
+        WritePhaseJson(f, "new_frame", r.NewFrame, false);
+        WritePhaseJson(f, "submit", r.Submit, false);
+        WritePhaseJson(f, "end_frame", r.EndFrame, false);
+        WritePhaseJson(f, "render", r.Render, false);
+        WritePhaseJson(f, "total", r.Total, true);
+        fprintf(f, "      },\n");
+        fprintf(f, "      \"draw_data\": { \"cmd_lists\": %d, \"draw_cmds\": %d, \"draw_calls\": %d, \"vtx\": %d, \"idx\": %d, \"max_vtx\": %d, \"max_idx\": %d, \"render_windows\": %d },\n",
+            r.CmdListsCount, r.CmdCount, r.DrawCallsCount, r.VtxCount, r.IdxCount, r.MaxVtxCount, r.MaxIdxCount, r.WindowsCount);
+        fprintf(f, "      \"allocations\": { \"total\": %d, \"max_per_frame\": %d, \"max_frame_arena_bytes\": %d",
+            r.TotalFrameAllocations, r.MaxFrameAllocations, r.MaxFrameArenaBytes);
+        if (!r.AllocSites.empty())
+        {
+            fprintf(f, ", \"sites\": [");
+            for (size_t site_n = 0; site_n < r.AllocSites.size(); site_n++)
+                fprintf(f, "%s{ \"name\": \"%s\", \"count\": %d }", site_n ? ", " : " ", r.AllocSites[site_n].Name.c_str(), r.AllocSites[site_n].Count);
+            fprintf(f, " ]");
+        }
+        fprintf(f, " },\n");
+        fprintf(f, "      \"active_windows\": %d, \"submit_us_per_window\": %.4f",
+            r.ActiveWindowsCount, r.ActiveWindowsCount > 0 ? r.Submit.Mean() * 1000.0 / r.ActiveWindowsCount : 0.0);
+#ifdef IMGUI_ENABLE_PROFILER
+        fprintf(f, ",\n      \"profiler_zones\": [\n");
+        for (size_t zone_n = 0; zone_n < r.Zones.size(); zone_n++)
+            fprintf(f, "        { \"name\": \"%s\", \"calls_per_frame\": %.1f, \"ms_per_frame\": %.4f }%s\n",
+                r.Zones[zone_n].Name, (double)r.Zones[zone_n].Count / frames, r.Zones[zone_n].TotalMs / frames, (zone_n + 1 < r.Zones.size()) ? "," : "");
+        fprintf(f, "      ]");
+#endif
+        fprintf(f, "\n");
+        fprintf(f, "    }%s\n", (n + 1 < results.size()) ? "," : "");
+    }
+    fprintf(f, "  ],\n");
+    fprintf(f, "  \"micro\": [\n");
+    for (size_t n = 0; n < micro_results.size(); n++)
+    {
+        const BenchMicroResult& r = micro_results[n];
+        fprintf(f, "    { \"name\": \"%s\"", micros[n]->Name);
+        for (size_t metric_n = 0; metric_n < r.Metrics.size(); metric_n++)
+            fprintf(f, ", \"%s\": %.2f", r.Metrics[metric_n].Name, r.Metrics[metric_n].Value);
+        fprintf(f, " }%s\n", (n + 1 < micro_results.size()) ? "," : "");
+    }
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+}
+
+static const BenchWorkload* FindWorkload(const char* name)
+{
+    for (size_t n = 0; n < IM_ARRAYSIZE(g_Workloads); n++)
+        if (strcmp(g_Workloads[n].Name, name) == 0)
+            return &g_Workloads[n];
+    return NULL;
+}
+
+static const BenchMicro* FindMicro(const char* name)
+{
+    for (size_t n = 0; n < IM_ARRAYSIZE(g_Micros); n++)
+        if (strcmp(g_Micros[n].Name, name) == 0)
+            return &g_Micros[n];
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = 200;
+    int warmup = 10;
+    const char* output_filename = NULL;
+    bool defer_tessellation = false;
+    int threads = 1;
+    int text_cache_budget = 0;
+    bool draw_data_arena = false;
+    bool merge_commands = false;
+    bool cpu_clip = false;
+    bool check_allocations = false;
+    std::vector<const BenchWorkload*> workloads;
+    std::vector<const BenchMicro*> micros;
+
+    for (int n = 1; n < argc; n++)
+    {
+        const char* arg = argv[n];
+        const bool has_value = (n + 1 < argc);
+        if (strcmp(arg, "--frames") == 0 && has_value)
+            frames = atoi(argv[++n]);
+        else if (strcmp(arg, "--warmup") == 0 && has_value)
+            warmup = atoi(argv[++n]);
+        else if (strcmp(arg, "--output") == 0 && has_value)
+            output_filename = argv[++n];
+        else if (strcmp(arg, "--defer-tessellation") == 0)
+            defer_tessellation = true;
+        else if (strcmp(arg, "--threads") == 0 && has_value)
+            threads = atoi(argv[++n]);
+        else if (strcmp(arg, "--text-cache") == 0 && has_value)
+            text_cache_budget = atoi(argv[++n]);
+        else if (strcmp(arg, "--draw-data-arena") == 0)
+            draw_data_arena = true;
+        else if (strcmp(arg, "--merge-commands") == 0)
+            draw_data_arena = merge_commands = true;
+        else if (strcmp(arg, "--cpu-clip") == 0)
+            cpu_clip = true;
+        else if (strcmp(arg, "--check-allocations") == 0)
+            check_allocations = true;
+        else if (strcmp(arg, "--workload") == 0 && has_value)
+        {
+            const BenchWorkload* workload = FindWorkload(argv[++n]);
+            if (workload == NULL)
+            {
+                fprintf(stderr, "Unknown workload '%s', use --list to list them.\n", argv[n]);
+                return 1;
+            }
+            workloads.push_back(workload);
+        }
+        else if (strcmp(arg, "--micro") == 0 && has_value)
+        {
+            const BenchMicro* micro = FindMicro(argv[++n]);
+            if (micro == NULL)
+            {
+                fprintf(stderr, "Unknown micro-benchmark '%s', use --list to list them.\n", argv[n]);
+                return 1;
+            }
+            micros.push_back(micro);
+        }
+        else if (strcmp(arg, "--list") == 0)
+        {
+            printf("Workloads (--workload):\n");
+            for (size_t workload_n = 0; workload_n < IM_ARRAYSIZE(g_Workloads); workload_n++)
+                printf("  %-14s %s\n", g_Workloads[workload_n].Name, g_Workloads[workload_n].Desc);
+            printf("Micro-benchmarks (--micro):\n");
+            for (size_t micro_n = 0; micro_n < IM_ARRAYSIZE(g_Micros); micro_n++)
+                printf("  %-16s %s\n", g_Micros[micro_n].Name, g_Micros[micro_n].Desc);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--workload NAME]... [--micro NAME]... [--output FILE] [--list] [--defer-tessellation] [--threads N] [--text-cache BYTES] [--draw-data-arena] [--merge-commands] [--cpu-clip] [--check-allocations]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (frames <= 0)
+        frames = 1;
+    if (threads <= 0)
+        threads = 1;
+    if (workloads.empty() && micros.empty())
+    {
+        for (size_t n = 0; n < IM_ARRAYSIZE(g_Workloads); n++)
+            workloads.push_back(&g_Workloads[n]);
+        for (size_t n = 0; n < IM_ARRAYSIZE(g_Micros); n++)
+            micros.push_back(&g_Micros[n]);
+    }
+
+    BenchThreadPool* thread_pool = (threads > 1) ? new BenchThreadPool(threads) : NULL;
+    std::vector<BenchResult> results(workloads.size());
+    for (size_t n = 0; n < workloads.size(); n++)
+    {
+        fprintf(stderr, "Running '%s' (%d frames)...\n", workloads[n]->Name, frames);
+        RunWorkload(workloads[n], frames, warmup, defer_tessellation, thread_pool, text_cache_budget, draw_data_arena, merge_commands, cpu_clip, &results[n]);
+    }
+    delete thread_pool;
+    std::vector<BenchMicroResult> micro_results(micros.size());
+    for (size_t n = 0; n < micros.size(); n++)
+    {
+        fprintf(stderr, "Running micro-benchmark '%s'...\n", micros[n]->Name);
+        micros[n]->Run(&micro_results[n]);
+    }
+
+    FILE* f = stdout;
+    if (output_filename && (f = fopen(output_filename, "wt")) == NULL)
+    {
+        fprintf(stderr, "Could not open '%s' for writing.\n", output_filename);
+        return 1;
+    }
+    WriteResultsJson(f, results, micros, micro_results, frames, warmup, defer_tessellation, threads, text_cache_budget, draw_data_arena, merge_commands, cpu_clip);
+    if (f != stdout)
+        fclose(f);
+
+    // Steady-state frames shouldn't allocate: any allocation is a potential latency spike
+    int ret = 0;
+    for (size_t n = 0; n < results.size() && check_allocations; n++)
+    {
+        const BenchResult& r = results[n];
+        if (r.TotalFrameAllocations == 0)
+            continue;
+        if (r.Workload->AllocsReason != NULL)
+        {
+            fprintf(stderr, "Ignored: '%s' made %d heap allocations during %d measured frames: %s.\n", r.Workload->Name, r.TotalFrameAllocations, frames, r.Workload->AllocsReason);
+            continue;
+        }
+        fprintf(stderr, "FAILED: '%s' made %d heap allocations during %d measured frames (max %d per frame).\n", r.Workload->Name, r.TotalFrameAllocations, frames, r.MaxFrameAllocations);
+        for (size_t site_n = 0; site_n < r.AllocSites.size(); site_n++)
+            fprintf(stderr, "  %6d  %s\n", r.AllocSites[site_n].Count, r.AllocSites[site_n].Name.c_str());
+        ret = 1;
+    }
+    return ret;
+}
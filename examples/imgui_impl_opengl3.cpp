@@ -6,6 +6,9 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Desktop GL only: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [x] Renderer: Desktop GL only: Upload the vertices/indices of the whole frame at once (ImGuiBackendFlags_RendererHasDrawDataArena).
+//  [X] Renderer: Support for the compact vertex format (#define IMGUI_USE_COMPACT_DRAWVERT).
+//  [x] Renderer: Desktop GL only: Persistently mapped ring buffer for vertices/indices (ImGui_ImplOpenGL3_EnableRingBuffer).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See main.cpp for an example of using this.
 // If you are new to dear imgui, read examples/README.txt and read the documentation at the top of imgui.cpp.
@@ -13,6 +16,10 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2020-05-26: OpenGL: Desktop GL 3.2+: Added ImGui_ImplOpenGL3_EnableRingBuffer() to build the draw data arena directly into a mapped, triple-buffered ring buffer (persistently mapped with GL 4.4+/ARB_buffer_storage).
+//  2020-05-25: OpenGL: Support for the compact vertex format (#define IMGUI_USE_COMPACT_DRAWVERT): 16-bit fixed point positions scaled by the projection matrix, normalized 16-bit UV.
+//  2020-05-22: OpenGL: Skip empty draw commands (left by io.ConfigDrawDataMergeCommands).
+//  2020-05-20: OpenGL: Desktop GL 3.2+: Upload all vertices/indices at once using the draw data arena, enable ImGuiBackendFlags_RendererHasDrawDataArena flag.
 //  2020-05-08: OpenGL: Made default GLSL version 150 (instead of 130) on OSX.
 //  2020-04-21: OpenGL: Fixed handling of glClipControl(GL_UPPER_LEFT) by inverting projection matrix.
 //  2020-04-12: OpenGL: Fixed context version check mistakenly testing for 4.0+ instead of 3.2+ to enable ImGuiBackendFlags_RendererHasVtxOffset.
@@ -127,6 +134,13 @@ using namespace gl;
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET   1
 #endif
 
+// Desktop GL 4.4+ (or GL_ARB_buffer_storage) has glBufferStorage() for persistently mapped buffers.
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET && defined(GL_MAP_PERSISTENT_BIT)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE   1
+#else
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE   0
+#endif
+
 // OpenGL Data
 static GLuint       g_GlVersion = 0;                // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
 static char         g_GlslVersionString[32] = "";   // Specified by user or detected based on compile time GL settings.
@@ -136,6 +150,21 @@ static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static int          g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
 
+// Ring buffer (see ImGui_ImplOpenGL3_EnableRingBuffer): Render() allocates the draw data arena directly in one of its segments.
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+#define IMGUI_IMPL_OPENGL_RING_SEGMENTS 3
+static bool         g_RingEnabled = false;
+static bool         g_RingPersistent = false;       // Whole buffer persistently mapped with glBufferStorage(), otherwise each segment is mapped with glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT) then unmapped before drawing
+static GLuint       g_RingHandle = 0;
+static GLsizeiptr   g_RingSegmentSize = 0;
+static char*        g_RingMappedData = NULL;        // Persistent mapping of the whole buffer
+static GLsync       g_RingFences[IMGUI_IMPL_OPENGL_RING_SEGMENTS] = {};
+static int          g_RingSegment = 0;
+static const void*  g_RingFrameVtxBuffer = NULL;    // Draw data arena allocated by the last Render() call
+static GLsizeiptr   g_RingFrameVtxOffset = 0, g_RingFrameIdxOffset = 0;
+static bool         g_RingFrameMapped = false;
+#endif
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -154,7 +183,10 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     io.BackendRendererName = "imgui_impl_opengl3";
 #if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
     if (g_GlVersion >= 320)
-        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    {
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;      // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasDrawDataArena;  // We can upload ImDrawData::ArenaVtxBuffer/ArenaIdxBuffer at once.
+    }
 #endif
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
@@ -211,6 +243,15 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 void    ImGui_ImplOpenGL3_Shutdown()
 {
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    if (g_RingEnabled)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DrawDataArenaAllocFn = NULL;
+        io.DrawDataArenaUserData = NULL;
+        g_RingEnabled = false;
+    }
+#endif
 }
 
 void    ImGui_ImplOpenGL3_NewFrame()
@@ -219,6 +260,154 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+static void ImGui_ImplOpenGL3_DestroyRingBuffer()
+{
+    if (g_RingHandle)
+    {
+        if (g_RingMappedData != NULL || g_RingFrameMapped)
+        {
+            GLint last_copy_write_buffer; glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &last_copy_write_buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, g_RingHandle);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, last_copy_write_buffer);
+        }
+        glDeleteBuffers(1, &g_RingHandle); // The GL keeps the storage alive until pending draws are done with it
+    }
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_RING_SEGMENTS; n++)
+        if (g_RingFences[n])
+        {
+            glDeleteSync(g_RingFences[n]);
+            g_RingFences[n] = 0;
+        }
+    g_RingHandle = 0;
+    g_RingSegmentSize = 0;
+    g_RingSegment = 0;
+    g_RingMappedData = NULL;
+    g_RingFrameVtxBuffer = NULL;
+    g_RingFrameMapped = false;
+}
+
+// Called by ImGui::Render() (with our GL context current) to provide the memory of the draw data arena: a segment of the ring buffer.
+// Layout of a segment: vertices, then indices (starting on a 256 bytes boundary). We wait on the fence of the segment before reusing it.
+static bool ImGui_ImplOpenGL3_DrawDataArenaAlloc(void*, int vtx_count, int idx_count, void** out_vtx_buffer, void** out_idx_buffer)
+{
+    GLint last_copy_write_buffer; glGetIntegerv(GL_COPY_WRITE_BUFFER_BINDING, &last_copy_write_buffer);
+
+    // Unmap the previous frame if it wasn't rendered
+    if (g_RingFrameMapped)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, g_RingHandle);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        g_RingFrameMapped = false;
+    }
+    g_RingFrameVtxBuffer = NULL;
+
+    // Nothing to upload (e.g. first frame): the ring buffer may not exist yet, don't bind or map anything
+    if (vtx_count == 0 && idx_count == 0)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, last_copy_write_buffer);
+        return false;
+    }
+
+    // (Re)create the buffer when a frame doesn't fit in a segment, otherwise move to the next segment
+    const GLsizeiptr vtx_size = ((GLsizeiptr)vtx_count * (GLsizeiptr)sizeof(ImDrawVert) + 255) & ~(GLsizeiptr)255;
+    const GLsizeiptr needed_size = vtx_size + (GLsizeiptr)idx_count * (GLsizeiptr)sizeof(ImDrawIdx);
+    if (needed_size > g_RingSegmentSize)
+    {
+        ImGui_ImplOpenGL3_DestroyRingBuffer();
+        g_RingSegmentSize = ((needed_size + needed_size / 2) | 0xFFFF) + 1; // Grow by 50%, multiple of 64 KB
+        const GLsizeiptr buffer_size = g_RingSegmentSize * IMGUI_IMPL_OPENGL_RING_SEGMENTS;
+        glGenBuffers(1, &g_RingHandle);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, g_RingHandle);
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (g_RingPersistent)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_COPY_WRITE_BUFFER, buffer_size, NULL, flags);
+            g_RingMappedData = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, buffer_size, flags);
+        }
+        else
+#endif
+        {
+            glBufferData(GL_COPY_WRITE_BUFFER, buffer_size, NULL, GL_STREAM_DRAW);
+        }
+    }
+    else
+    {
+        g_RingSegment = (g_RingSegment + 1) % IMGUI_IMPL_OPENGL_RING_SEGMENTS;
+        if (GLsync fence = g_RingFences[g_RingSegment])
+        {
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {}
+            glDeleteSync(fence);
+            g_RingFences[g_RingSegment] = 0;
+        }
+    }
+
+    // Map the segment (the GPU is done with it, so we don't need the driver to synchronize)
+    const GLsizeiptr segment_offset = g_RingSegmentSize * g_RingSegment;
+    char* segment_data = NULL;
+    if (g_RingPersistent)
+    {
+        segment_data = g_RingMappedData ? g_RingMappedData + segment_offset : NULL;
+    }
+    else
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, g_RingHandle);
+        segment_data = (char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, segment_offset, g_RingSegmentSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        g_RingFrameMapped = (segment_data != NULL);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, last_copy_write_buffer);
+    if (segment_data == NULL)
+        return false; // Fallback to memory owned by the imgui context, uploaded with glBufferData()
+
+    g_RingFrameVtxBuffer = segment_data;
+    g_RingFrameVtxOffset = segment_offset;
+    g_RingFrameIdxOffset = segment_offset + vtx_size;
+    *out_vtx_buffer = segment_data;
+    *out_idx_buffer = segment_data + vtx_size;
+    return true;
+}
+#endif
+
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static bool ImGui_ImplOpenGL3_HasExtension(const char* name)
+{
+    GLint extensions_count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions_count);
+    for (GLint n = 0; n < extensions_count; n++)
+        if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, (GLuint)n), name) == 0)
+            return true;
+    return false;
+}
+#endif
+
+// Desktop GL 3.2+ only: Render() writes vertices/indices directly in a triple-buffered ring buffer, instead of uploading them with glBufferData() every frame.
+// Uses a persistently mapped buffer when GL 4.4 or GL_ARB_buffer_storage are available (and 'allow_persistent_mapping' is set), otherwise maps
+// each frame segment with glMapBufferRange(GL_MAP_UNSYNCHRONIZED_BIT). Segments are reused once their fence is signaled.
+// The GL context needs to be current when calling ImGui::Render(). Sets io.DrawDataArenaAllocFn. Returns false if not supported.
+bool    ImGui_ImplOpenGL3_EnableRingBuffer(bool allow_persistent_mapping)
+{
+    IM_UNUSED(allow_persistent_mapping);
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    ImGuiIO& io = ImGui::GetIO();
+    if (!(io.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena))
+        return false;
+    ImGui_ImplOpenGL3_DestroyRingBuffer();
+    g_RingPersistent = false;
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (allow_persistent_mapping && (g_GlVersion >= 440 || ImGui_ImplOpenGL3_HasExtension("GL_ARB_buffer_storage")))
+        g_RingPersistent = true;
+#endif
+    g_RingEnabled = true;
+    io.DrawDataArenaAllocFn = ImGui_ImplOpenGL3_DrawDataArenaAlloc;
+    io.DrawDataArenaUserData = NULL;
+    return true;
+#else
+    return false;
+#endif
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
@@ -248,10 +437,15 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     float T = draw_data->DisplayPos.y;
     float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
     if (!clip_origin_lower_left) { float tmp = T; T = B; B = tmp; } // Swap top and bottom if origin is upper left
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const float S = 1.0f / IMGUI_COMPACT_DRAWVERT_POS_SCALE; // Vertex positions are 16-bit fixed point (see ImDrawVertPos16)
+#else
+    const float S = 1.0f;
+#endif
     const float ortho_projection[4][4] =
     {
-        { 2.0f/(R-L),   0.0f,         0.0f,   0.0f },
-        { 0.0f,         2.0f/(T-B),   0.0f,   0.0f },
+        { 2.0f*S/(R-L), 0.0f,         0.0f,   0.0f },
+        { 0.0f,         2.0f*S/(T-B), 0.0f,   0.0f },
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
@@ -268,14 +462,31 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+    intptr_t vtx_offset = 0;
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    if (g_RingFrameVtxBuffer != NULL && draw_data->ArenaVtxBuffer == g_RingFrameVtxBuffer)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, g_RingHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_RingHandle);
+        vtx_offset = (intptr_t)g_RingFrameVtxOffset;
+    }
+    else
+#endif
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+    }
     glEnableVertexAttribArray(g_AttribLocationVtxPos);
     glEnableVertexAttribArray(g_AttribLocationVtxUV);
     glEnableVertexAttribArray(g_AttribLocationVtxColor);
-    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
-    glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_SHORT,          GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_UNSIGNED_SHORT, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, uv)));
+#else
+    glVertexAttribPointer(g_AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer(g_AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, uv)));
+#endif
+    glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(vtx_offset + IM_OFFSETOF(ImDrawVert, col)));
 }
 
 // OpenGL3 Render function.
@@ -330,18 +541,41 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // Upload vertex/index buffers of the whole frame at once when the draw data arena is available.
+    // When the arena was allocated in our ring buffer, vertices/indices are already in place (only unmap the segment when not persistently mapped).
+    const ImDrawCmd* arena_cmd = draw_data->ArenaCmdBuffer;
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    const bool use_ring = (arena_cmd != NULL && g_RingFrameVtxBuffer != NULL && draw_data->ArenaVtxBuffer == g_RingFrameVtxBuffer);
+    const intptr_t idx_buffer_offset = use_ring ? (intptr_t)g_RingFrameIdxOffset : 0;
+    if (use_ring && g_RingFrameMapped)
+    {
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        g_RingFrameMapped = false;
+    }
+#else
+    const bool use_ring = false;
+#endif
+    if (arena_cmd != NULL && !use_ring)
+    {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_data->TotalVtxCount * sizeof(ImDrawVert), (const GLvoid*)draw_data->ArenaVtxBuffer, GL_STREAM_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)draw_data->TotalIdxCount * sizeof(ImDrawIdx), (const GLvoid*)draw_data->ArenaIdxBuffer, GL_STREAM_DRAW);
+    }
+
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
         // Upload vertex/index buffers
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        if (arena_cmd == NULL)
+        {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
-            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            const ImDrawCmd* pcmd = arena_cmd ? arena_cmd++ : &cmd_list->CmdBuffer[cmd_i];
             if (pcmd->UserCallback != NULL)
             {
                 // User callback, registered via ImDrawList::AddCallback()
@@ -351,7 +585,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
-            else
+            else if (pcmd->ElemCount > 0) // Commands merged into a previous one by io.ConfigDrawDataMergeCommands are left empty
             {
                 // Project scissor/clipping rectangles into framebuffer space
                 ImVec4 clip_rect;
@@ -369,7 +603,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
 #if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                     if (g_GlVersion >= 320)
-                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(idx_buffer_offset + (intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))), (GLint)pcmd->VtxOffset);
                     else
 #endif
                     glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
@@ -378,6 +612,16 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         }
     }
 
+    // Fence the ring buffer segment: it will be reused once the GPU is done with it
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    if (use_ring)
+    {
+        if (g_RingFences[g_RingSegment])
+            glDeleteSync(g_RingFences[g_RingSegment]);
+        g_RingFences[g_RingSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+
     // Destroy the temporary VAO
 #ifndef IMGUI_IMPL_OPENGL_ES2
     glDeleteVertexArrays(1, &vertex_array_object);
@@ -665,6 +909,9 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
+#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    ImGui_ImplOpenGL3_DestroyRingBuffer();
+#endif
     if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
     if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Support for the compact vertex format (#define IMGUI_USE_COMPACT_DRAWVERT).
 // Missing features:
 //  [ ] Renderer: User texture binding. Changes of ImTextureID aren't supported by this binding! See https://github.com/ocornut/imgui/pull/914
 
@@ -22,6 +23,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2020-05-25: Vulkan: Support for the compact vertex format (#define IMGUI_USE_COMPACT_DRAWVERT): 16-bit positions as SNORM rescaled by the push constants, UNORM 16-bit UV.
 //  2020-05-04: Vulkan: Fixed crash if initial frame has no vertices.
 //  2020-04-26: Vulkan: Fixed edge case where render callbacks wouldn't be called if the ImDrawData didn't have vertices.
 //  2019-08-01: Vulkan: Added support for specifying multisample count. Set ImGui_ImplVulkan_InitInfo::MSAASamples to one of the VkSampleCountFlagBits values to use, default is non-multisampled as before.
@@ -305,6 +307,11 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkCommandBu
         float translate[2];
         translate[0] = -1.0f - draw_data->DisplayPos.x * scale[0];
         translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        // Vertex positions are 16-bit fixed point (see ImDrawVertPos16), read as SNORM (value/32767)
+        scale[0] *= 32767.0f / IMGUI_COMPACT_DRAWVERT_POS_SCALE;
+        scale[1] *= 32767.0f / IMGUI_COMPACT_DRAWVERT_POS_SCALE;
+#endif
         vkCmdPushConstants(command_buffer, g_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
         vkCmdPushConstants(command_buffer, g_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
     }
@@ -688,11 +695,19 @@ bool ImGui_ImplVulkan_CreateDeviceObjects()
     VkVertexInputAttributeDescription attribute_desc[3] = {};
     attribute_desc[0].location = 0;
     attribute_desc[0].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[0].format = VK_FORMAT_R16G16_SNORM;
+#else
     attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[0].offset = IM_OFFSETOF(ImDrawVert, pos);
     attribute_desc[1].location = 1;
     attribute_desc[1].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[1].format = VK_FORMAT_R16G16_UNORM;
+#else
     attribute_desc[1].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[1].offset = IM_OFFSETOF(ImDrawVert, uv);
     attribute_desc[2].location = 2;
     attribute_desc[2].binding = binding_desc[0].binding;
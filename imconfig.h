@@ -80,6 +80,30 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use a compact 12 bytes ImDrawVert (default is 20 bytes): positions as signed 16-bit fixed point, UV as normalized 16-bit, color as ImU32.
+// Reduces the memory bandwidth of building/uploading vertices by 40%. Positions are rounded to 1/(1<<IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS) pixel
+// and clamped to +/-(32767>>IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS) pixels (default 2 bits: 1/4 pixel, +/-8191 pixels), UV are clamped to [0,1] (no texture repeat).
+// Encoding costs CPU time when generating vertices: ~10% slower with SSE2/NEON, up to ~40% slower for anti-aliased lines without them (IMGUI_DISABLE_SIMD).
+// Only worth it when the GPU upload or memory bandwidth is the bottleneck.
+// Your renderer back-end will need to support it (imgui_impl_opengl3 and imgui_impl_vulkan do). See ImDrawVertPos16/ImDrawVertUV16 in imgui.h.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+//#define IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS 2
+
+//---- Use a faster function to hash IDs (default is a byte-wise CRC32 using a 1KB lookup table).
+// - IMGUI_USE_WORD_HASH: portable word-at-a-time hash (MurmurHash3). Values depend on the CPU endianness.
+// - IMGUI_USE_CRC32C_HASH: CRC32C using the SSE4.2 'crc32' instruction when available at compile time (e.g. -msse4.2 or /arch:AVX), otherwise a table-driven fallback producing the same values.
+// The "label###id" syntax is supported by all functions. Changing the hash function changes every ImGuiID value, so any ID you persist yourself becomes invalid.
+// The function in use is stored in .ini files (when not the default), see ImGuiContext::SettingsHashMismatch.
+//#define IMGUI_USE_WORD_HASH
+//#define IMGUI_USE_CRC32C_HASH
+
+//---- Don't use SSE2/NEON intrinsics (detected at compile time from the target architecture), always use the scalar code paths.
+//#define IMGUI_DISABLE_SIMD
+
+//---- Use an open-addressing hash table for ImGuiStorage (default is a sorted array with O(log N) queries and O(N) insertion).
+// Faster insertion when creating many tree nodes/collapsing headers/windows at once. Data[] then contains unused slots (with a zero key).
+//#define IMGUI_USE_HASHED_STORAGE
+
 //---- Override ImDrawCallback signature (will need to modify renderer back-ends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
@@ -99,6 +123,16 @@
 //---- Debug Tools: Enable slower asserts
 //#define IMGUI_DEBUG_PARANOID
 
+//---- Debug Tools: Record CPU zones around NewFrame()/Begin()/End()/ItemAdd()/EndFrame()/Render() sub-steps.
+// Zones are displayed in 'Metrics->Profiler' and may be forwarded to your own tracer with ImGui::SetProfilerZoneCallback() (in imgui_internal.h).
+// This adds a small runtime cost to every window and item, which is why it is not enabled by default.
+//#define IMGUI_ENABLE_PROFILER
+
+//---- Debug Tools: Record the number and size of allocations per call site: file/line of IM_ALLOC()/IM_NEW(), or the innermost IMGUI_ALLOC_SCOPE()
+// (ImVector<> growth within ImDrawList, ImPool, ImChunkStream and ImFontAtlas functions is attributed to them). Displayed in 'Metrics->Allocations'.
+// This adds a small runtime cost to every allocation, which is why it is not enabled by default.
+//#define IMGUI_ENABLE_ALLOC_TRACKING
+
 //---- Tip: You can add extra functions within the ImGui:: namespace, here or in your own headers files.
 /*
 namespace ImGui
@@ -61,7 +61,7 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
-// [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -75,6 +75,7 @@ CODE
 // [SECTION] DRAG AND DROP
 // [SECTION] LOGGING/CAPTURING
 // [SECTION] SETTINGS
+// [SECTION] PROFILER
 // [SECTION] PLATFORM DEPENDENT HELPERS
 // [SECTION] METRICS/DEBUG WINDOW
 
@@ -821,6 +822,19 @@ CODE
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#ifdef IMGUI_ENABLE_PROFILER
+#include <time.h>       // clock_gettime, clock
+#endif
+#if defined(IMGUI_USE_WORD_HASH) && defined(IMGUI_USE_CRC32C_HASH)
+#error "IMGUI_USE_WORD_HASH and IMGUI_USE_CRC32C_HASH are mutually exclusive."
+#endif
+#if defined(IMGUI_USE_CRC32C_HASH) && (defined(__SSE4_2__) || defined(__AVX__))
+#include <nmmintrin.h>  // _mm_crc32_u8, _mm_crc32_u32, _mm_crc32_u64
+#define IMGUI_CRC32C_USE_SSE42
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>     // _InterlockedExchangeAdd
+#endif
 
 // [Windows] OS specific includes (optional)
 #if defined(_WIN32) && defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) && defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
@@ -908,15 +922,19 @@ static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 2.00f;    // Lock
 
 static void             SetCurrentWindow(ImGuiWindow* window);
 static void             FindHoveredWindow();
+static void             BuildWindowsHitGrid();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiWindowFlags flags);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window, bool snap_on_edges);
 
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
-static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
+static void             AddWindowToSortBuffer(ImGuiWindow** out_sorted_windows, int* out_sorted_count, ImGuiWindow* window);
 
 static ImRect           GetViewportRect();
 
 // Settings
+static void             HashSettingsHandler_ReadInit(ImGuiContext*, ImGuiSettingsHandler*);
+static void*            HashSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
+static void             HashSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void             WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
@@ -960,6 +978,7 @@ static bool             UpdateWindowManualResize(ImGuiWindow* window, const ImVe
 static void             RenderWindowOuterBorders(ImGuiWindow* window);
 static void             RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar_rect, bool title_bar_is_highlight, int resize_grip_count, const ImU32 resize_grip_col[4], float resize_grip_draw_size);
 static void             RenderWindowTitleBarContents(ImGuiWindow* window, const ImRect& title_bar_rect, const char* name, bool* p_open);
+static void             UpdateWindowDrawListCache(ImGuiWindow* window, const ImRect& host_rect, bool title_bar_is_highlight, bool want_focus);
 
 }
 
@@ -1114,6 +1133,13 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigWindowsMemoryCompactTimer = 60.0f;
+    ConfigMemoryCompactBudget = 0;
+    ConfigDrawListsDeferTessellation = false;
+    ConfigDrawListsShrinkFrames = 0;
+    ConfigDrawListsPreSize = false;
+    ConfigDrawListsCpuClipRect = false;
+    ConfigDrawDataMergeCommands = false;
+    ConfigTextCacheBudget = 0;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1123,6 +1149,10 @@ ImGuiIO::ImGuiIO()
     ClipboardUserData = NULL;
     ImeSetInputScreenPosFn = ImeSetInputScreenPosFn_DefaultImpl;
     ImeWindowHandle = NULL;
+    ParallelForFn = NULL;
+    ParallelForUserData = NULL;
+    DrawDataArenaAllocFn = NULL;
+    DrawDataArenaUserData = NULL;
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     RenderDrawListsFn = NULL;
@@ -1311,6 +1341,72 @@ ImVec2 ImTriangleClosestPoint(const ImVec2& a, const ImVec2& b, const ImVec2& c,
     return proj_ca;
 }
 
+void ImRectGrid::Build()
+{
+    // Bounding box of non-empty rectangles, clamped so cell coordinates are always finite
+    CellsStart.resize(0);
+    CellsRects.resize(0);
+    CellsX = CellsY = 0;
+    Bounds = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int n = 0; n < Rects.Size; n++)
+        if (Rects[n].Min.x < Rects[n].Max.x && Rects[n].Min.y < Rects[n].Max.y)
+            Bounds.Add(Rects[n]);
+    if (!(Bounds.Min.x < Bounds.Max.x))
+        return;
+    const float bounds_limit = FLT_MAX * 0.25f;
+    Bounds.ClipWith(ImRect(-bounds_limit, -bounds_limit, bounds_limit, bounds_limit));
+
+    // About one cell per rectangle following the aspect ratio of the bounding box, up to 256x256 cells
+    const float cells_count = (float)ImClamp(Rects.Size, 1, 256 * 256);
+    const float aspect = Bounds.GetWidth() / Bounds.GetHeight();
+    CellsX = (int)ImClamp(ImSqrt(cells_count * aspect), 1.0f, 256.0f);
+    CellsY = (int)ImClamp(cells_count / (float)CellsX, 1.0f, 256.0f);
+    CellsScale = ImVec2((float)CellsX / Bounds.GetWidth(), (float)CellsY / Bounds.GetHeight());
+
+    // Counting sort of rectangles into the cells they overlap, preserving their order
+    CellsStart.resize(CellsX * CellsY + 1);
+    memset(CellsStart.Data, 0, (size_t)CellsStart.size_in_bytes());
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int n = 0; n < Rects.Size; n++)
+        {
+            const ImRect& r = Rects[n];
+            if (!(r.Min.x < r.Max.x && r.Min.y < r.Max.y))
+                continue;
+            const int x0 = GetCellX(ImMax(r.Min.x, Bounds.Min.x)), x1 = GetCellX(ImMin(r.Max.x, Bounds.Max.x));
+            const int y0 = GetCellY(ImMax(r.Min.y, Bounds.Min.y)), y1 = GetCellY(ImMin(r.Max.y, Bounds.Max.y));
+            for (int y = y0; y <= y1; y++)
+                for (int x = x0; x <= x1; x++)
+                {
+                    const int cell = y * CellsX + x;
+                    if (pass == 0)
+                        CellsStart[cell + 1]++;
+                    else
+                        CellsRects[CellsStart[cell + 1]++] = n;
+                }
+        }
+        if (pass == 0)
+        {
+            for (int cell = 0; cell < CellsX * CellsY; cell++)
+                CellsStart[cell + 1] += CellsStart[cell];
+            CellsRects.resize(CellsStart.back());
+            for (int cell = CellsX * CellsY; cell > 0; cell--) // Shift to use as write cursors, the second pass shifts them back
+                CellsStart[cell] = CellsStart[cell - 1];
+        }
+    }
+}
+
+int ImRectGrid::FindFrontMost(const ImVec2& p) const
+{
+    if (CellsX == 0 || !Bounds.Contains(p))
+        return -1;
+    const int cell = GetCellY(p.y) * CellsX + GetCellX(p.x);
+    for (int n = CellsStart[cell + 1] - 1; n >= CellsStart[cell]; n--)
+        if (Rects[CellsRects[n]].Contains(p))
+            return CellsRects[n];
+    return -1;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (String, Format, Hash functions)
 //-----------------------------------------------------------------------------
@@ -1485,6 +1581,8 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+#if !defined(IMGUI_USE_WORD_HASH) && !defined(IMGUI_USE_CRC32C_HASH)
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1510,7 +1608,7 @@ static const ImU32 GCrc32LookupTable[256] =
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// FIXME-OPT: CRC32 pretty much randomly access 1KB. See IMGUI_USE_WORD_HASH/IMGUI_USE_CRC32C_HASH in imconfig.h for faster alternatives.
 ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 {
     ImU32 crc = ~seed;
@@ -1526,7 +1624,7 @@ ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// FIXME-OPT: CRC32 pretty much randomly access 1KB. See IMGUI_USE_WORD_HASH/IMGUI_USE_CRC32C_HASH in imconfig.h for faster alternatives.
 ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 {
     seed = ~seed;
@@ -1555,6 +1653,143 @@ ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+const char* ImHashGetFunctionName()
+{
+    return "CRC32";
+}
+
+#else // #if !defined(IMGUI_USE_WORD_HASH) && !defined(IMGUI_USE_CRC32C_HASH)
+
+// Faster hash functions, enabled with IMGUI_USE_WORD_HASH or IMGUI_USE_CRC32C_HASH in imconfig.h.
+// They don't have a byte-wise "###" check in their inner loop: ImHashStr() looks for the last "###" first and only hashes from there,
+// which is equivalent to resetting to the seed value every time we reach ###.
+#ifdef IMGUI_USE_CRC32C_HASH
+
+#ifndef IMGUI_CRC32C_USE_SSE42
+// CRC32C (Castagnoli polynomial 0x1EDC6F41, reflected 0x82F63B78) lookup table, only used when the SSE4.2 instruction is not available.
+static const ImU32 GCrc32cLookupTable[256] =
+{
+    0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
+    0x105EC76F,0xE235446C,0xF165B798,0x030E349B,0xD7C45070,0x25AFD373,0x36FF2087,0xC494A384,0x9A879FA0,0x68EC1CA3,0x7BBCEF57,0x89D76C54,0x5D1D08BF,0xAF768BBC,0xBC267848,0x4E4DFB4B,
+    0x20BD8EDE,0xD2D60DDD,0xC186FE29,0x33ED7D2A,0xE72719C1,0x154C9AC2,0x061C6936,0xF477EA35,0xAA64D611,0x580F5512,0x4B5FA6E6,0xB93425E5,0x6DFE410E,0x9F95C20D,0x8CC531F9,0x7EAEB2FA,
+    0x30E349B1,0xC288CAB2,0xD1D83946,0x23B3BA45,0xF779DEAE,0x05125DAD,0x1642AE59,0xE4292D5A,0xBA3A117E,0x4851927D,0x5B016189,0xA96AE28A,0x7DA08661,0x8FCB0562,0x9C9BF696,0x6EF07595,
+    0x417B1DBC,0xB3109EBF,0xA0406D4B,0x522BEE48,0x86E18AA3,0x748A09A0,0x67DAFA54,0x95B17957,0xCBA24573,0x39C9C670,0x2A993584,0xD8F2B687,0x0C38D26C,0xFE53516F,0xED03A29B,0x1F682198,
+    0x5125DAD3,0xA34E59D0,0xB01EAA24,0x42752927,0x96BF4DCC,0x64D4CECF,0x77843D3B,0x85EFBE38,0xDBFC821C,0x2997011F,0x3AC7F2EB,0xC8AC71E8,0x1C661503,0xEE0D9600,0xFD5D65F4,0x0F36E6F7,
+    0x61C69362,0x93AD1061,0x80FDE395,0x72966096,0xA65C047D,0x5437877E,0x4767748A,0xB50CF789,0xEB1FCBAD,0x197448AE,0x0A24BB5A,0xF84F3859,0x2C855CB2,0xDEEEDFB1,0xCDBE2C45,0x3FD5AF46,
+    0x7198540D,0x83F3D70E,0x90A324FA,0x62C8A7F9,0xB602C312,0x44694011,0x5739B3E5,0xA55230E6,0xFB410CC2,0x092A8FC1,0x1A7A7C35,0xE811FF36,0x3CDB9BDD,0xCEB018DE,0xDDE0EB2A,0x2F8B6829,
+    0x82F63B78,0x709DB87B,0x63CD4B8F,0x91A6C88C,0x456CAC67,0xB7072F64,0xA457DC90,0x563C5F93,0x082F63B7,0xFA44E0B4,0xE9141340,0x1B7F9043,0xCFB5F4A8,0x3DDE77AB,0x2E8E845F,0xDCE5075C,
+    0x92A8FC17,0x60C37F14,0x73938CE0,0x81F80FE3,0x55326B08,0xA759E80B,0xB4091BFF,0x466298FC,0x1871A4D8,0xEA1A27DB,0xF94AD42F,0x0B21572C,0xDFEB33C7,0x2D80B0C4,0x3ED04330,0xCCBBC033,
+    0xA24BB5A6,0x502036A5,0x4370C551,0xB11B4652,0x65D122B9,0x97BAA1BA,0x84EA524E,0x7681D14D,0x2892ED69,0xDAF96E6A,0xC9A99D9E,0x3BC21E9D,0xEF087A76,0x1D63F975,0x0E330A81,0xFC588982,
+    0xB21572C9,0x407EF1CA,0x532E023E,0xA145813D,0x758FE5D6,0x87E466D5,0x94B49521,0x66DF1622,0x38CC2A06,0xCAA7A905,0xD9F75AF1,0x2B9CD9F2,0xFF56BD19,0x0D3D3E1A,0x1E6DCDEE,0xEC064EED,
+    0xC38D26C4,0x31E6A5C7,0x22B65633,0xD0DDD530,0x0417B1DB,0xF67C32D8,0xE52CC12C,0x1747422F,0x49547E0B,0xBB3FFD08,0xA86F0EFC,0x5A048DFF,0x8ECEE914,0x7CA56A17,0x6FF599E3,0x9D9E1AE0,
+    0xD3D3E1AB,0x21B862A8,0x32E8915C,0xC083125F,0x144976B4,0xE622F5B7,0xF5720643,0x07198540,0x590AB964,0xAB613A67,0xB831C993,0x4A5A4A90,0x9E902E7B,0x6CFBAD78,0x7FAB5E8C,0x8DC0DD8F,
+    0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
+    0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351,
+};
+#endif
+
+static ImU32 ImHashBytes(const void* data_p, size_t data_size, ImU32 seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+#ifdef IMGUI_CRC32C_USE_SSE42
+#if defined(__x86_64__) || defined(_M_X64)
+    if (data_size >= 8)
+    {
+        ImU64 crc64 = crc;
+        for (; data_size >= 8; data_size -= 8, data += 8)
+        {
+            ImU64 word;
+            memcpy(&word, data, 8);
+            crc64 = _mm_crc32_u64(crc64, word);
+        }
+        crc = (ImU32)crc64;
+    }
+#endif
+    for (; data_size >= 4; data_size -= 4, data += 4)
+    {
+        ImU32 word;
+        memcpy(&word, data, 4);
+        crc = _mm_crc32_u32(crc, word);
+    }
+    while (data_size-- != 0)
+        crc = _mm_crc32_u8(crc, *data++);
+#else
+    const ImU32* crc32_lut = GCrc32cLookupTable;
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+#endif
+    return ~crc;
+}
+
+const char* ImHashGetFunctionName()
+{
+    return "CRC32C";
+}
+
+#else // #ifdef IMGUI_USE_CRC32C_HASH
+
+// MurmurHash3 (x86_32 variant) by Austin Appleby, public domain. Reads 4 bytes at a time.
+static inline ImU32 ImRotl32(ImU32 v, int r) { return (v << r) | (v >> (32 - r)); }
+
+static ImU32 ImHashBytes(const void* data_p, size_t data_size, ImU32 seed)
+{
+    const ImU32 c1 = 0xCC9E2D51;
+    const ImU32 c2 = 0x1B873593;
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU32 h = seed;
+    size_t remaining = data_size;
+    for (; remaining >= 4; remaining -= 4, data += 4)
+    {
+        ImU32 k;
+        memcpy(&k, data, 4);
+        k *= c1; k = ImRotl32(k, 15); k *= c2;
+        h ^= k; h = ImRotl32(h, 13); h = h * 5 + 0xE6546B64;
+    }
+    if (remaining > 0)
+    {
+        ImU32 k = data[0];
+        if (remaining > 1) k |= (ImU32)data[1] << 8;
+        if (remaining > 2) k |= (ImU32)data[2] << 16;
+        k *= c1; k = ImRotl32(k, 15); k *= c2;
+        h ^= k;
+    }
+    h ^= (ImU32)data_size;
+    h ^= h >> 16; h *= 0x85EBCA6B;
+    h ^= h >> 13; h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
+
+const char* ImHashGetFunctionName()
+{
+    return "Murmur3";
+}
+
+#endif // #ifdef IMGUI_USE_CRC32C_HASH
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    return ImHashBytes(data_p, data_size, seed);
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_end = data_p + data_size;
+    for (const char* p = data_p; p < data_end && (p = (const char*)memchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (p + 2 < data_end && p[1] == '#' && p[2] == '#')
+            data_p = p;
+    return ImHashBytes(data_p, (size_t)(data_end - data_p), seed);
+}
+
+#endif // #if !defined(IMGUI_USE_WORD_HASH) && !defined(IMGUI_USE_CRC32C_HASH)
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -1899,6 +2134,8 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
+#ifndef IMGUI_USE_HASHED_STORAGE
+
 // std::lower_bound but without the bullshit
 static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
 {
@@ -2043,6 +2280,187 @@ void ImGuiStorage::SetAllInt(int v)
         Data[i].val_i = v;
 }
 
+#else // #ifndef IMGUI_USE_HASHED_STORAGE
+
+// Open-addressing hash table with linear probing, enabled with '#define IMGUI_USE_HASHED_STORAGE' in imconfig.h.
+// Keys are already hashes but we still mix them, as IDs derived from consecutive integers or pointers may share their low bits.
+static inline ImU32 StorageSlotHash(ImGuiID key)
+{
+    key ^= key >> 16;
+    key *= 0x7FEB352D;
+    key ^= key >> 15;
+    return key;
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFindPair(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (key == 0)
+        return storage->ZeroKeyUsed ? const_cast<ImGuiStorage::ImGuiStoragePair*>(&storage->ZeroKeyPair) : NULL;
+    if (storage->Data.Size == 0)
+        return NULL;
+    const ImU32 mask = (ImU32)storage->Data.Size - 1;
+    for (ImU32 slot = StorageSlotHash(key) & mask; ; slot = (slot + 1) & mask)
+    {
+        ImGuiStorage::ImGuiStoragePair* pair = &storage->Data.Data[slot];
+        if (pair->key == key)
+            return pair;
+        if (pair->key == 0)
+            return NULL;
+    }
+}
+
+// Insert a key known to be missing, the table needs to have at least one unused slot.
+static ImGuiStorage::ImGuiStoragePair* StorageInsertPair(ImGuiStorage* storage, ImGuiID key)
+{
+    IM_ASSERT(key != 0 && storage->DataCount < storage->Data.Size);
+    const ImU32 mask = (ImU32)storage->Data.Size - 1;
+    ImU32 slot = StorageSlotHash(key) & mask;
+    while (storage->Data.Data[slot].key != 0)
+        slot = (slot + 1) & mask;
+    ImGuiStorage::ImGuiStoragePair* pair = &storage->Data.Data[slot];
+    pair->key = key;
+    storage->DataCount++;
+    return pair;
+}
+
+// Rebuild the table with 'new_size' slots from all pairs with a non-zero key currently in Data[]
+static void StorageRehash(ImGuiStorage* storage, int new_size)
+{
+    IM_ASSERT(new_size > 0 && (new_size & (new_size - 1)) == 0);
+    ImVector<ImGuiStorage::ImGuiStoragePair> old_data;
+    old_data.swap(storage->Data);
+    storage->Data.resize(new_size);
+    memset(storage->Data.Data, 0, (size_t)storage->Data.size_in_bytes());
+    storage->DataCount = 0;
+    for (int n = 0; n < old_data.Size; n++)
+        if (old_data[n].key != 0)
+        {
+            ImGuiStorage::ImGuiStoragePair* pair = StorageFindPair(storage, old_data[n].key);
+            if (pair == NULL)
+                pair = StorageInsertPair(storage, old_data[n].key);
+            *pair = old_data[n];
+        }
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrAddPair(ImGuiStorage* storage, ImGuiID key, bool* out_added)
+{
+    *out_added = false;
+    if (ImGuiStorage::ImGuiStoragePair* pair = StorageFindPair(storage, key))
+        return pair;
+    *out_added = true;
+    if (key == 0)
+    {
+        storage->ZeroKeyUsed = true;
+        return &storage->ZeroKeyPair;
+    }
+    // Keep the load factor under 3/4. Only grow when actually adding a key, so references to existing values stay valid otherwise.
+    if ((storage->DataCount + 1) * 4 > storage->Data.Size * 3)
+        StorageRehash(storage, storage->Data.Size ? storage->Data.Size * 2 : 16);
+    return StorageInsertPair(storage, key);
+}
+
+void ImGuiStorage::BuildSortByKey()
+{
+    int count = 0;
+    for (int n = 0; n < Data.Size; n++)
+        if (Data[n].key != 0)
+            count++;
+    int new_size = 16;
+    while (count * 4 > new_size * 3)
+        new_size *= 2;
+    StorageRehash(this, new_size);
+}
+
+int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
+{
+    ImGuiStoragePair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_i : default_val;
+}
+
+bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
+{
+    return GetInt(key, default_val ? 1 : 0) != 0;
+}
+
+float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
+{
+    ImGuiStoragePair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    ImGuiStoragePair* pair = StorageFindPair(this, key);
+    return pair ? pair->val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    bool added;
+    ImGuiStoragePair* pair = StorageFindOrAddPair(this, key, &added);
+    if (added)
+        pair->val_i = default_val;
+    return &pair->val_i;
+}
+
+bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
+{
+    return (bool*)GetIntRef(key, default_val ? 1 : 0);
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    bool added;
+    ImGuiStoragePair* pair = StorageFindOrAddPair(this, key, &added);
+    if (added)
+        pair->val_f = default_val;
+    return &pair->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    bool added;
+    ImGuiStoragePair* pair = StorageFindOrAddPair(this, key, &added);
+    if (added)
+        pair->val_p = default_val;
+    return &pair->val_p;
+}
+
+void ImGuiStorage::SetInt(ImGuiID key, int val)
+{
+    bool added;
+    StorageFindOrAddPair(this, key, &added)->val_i = val;
+}
+
+void ImGuiStorage::SetBool(ImGuiID key, bool val)
+{
+    SetInt(key, val ? 1 : 0);
+}
+
+void ImGuiStorage::SetFloat(ImGuiID key, float val)
+{
+    bool added;
+    StorageFindOrAddPair(this, key, &added)->val_f = val;
+}
+
+void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
+{
+    bool added;
+    StorageFindOrAddPair(this, key, &added)->val_p = val;
+}
+
+void ImGuiStorage::SetAllInt(int v)
+{
+    for (int i = 0; i < Data.Size; i++)
+        if (Data[i].key != 0)
+            Data[i].val_i = v;
+    if (ZeroKeyUsed)
+        ZeroKeyPair.val_i = v;
+}
+
+#endif // #ifndef IMGUI_USE_HASHED_STORAGE
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextFilter
 //-----------------------------------------------------------------------------
@@ -2146,7 +2564,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 }
 
 //-----------------------------------------------------------------------------
-// [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 //-----------------------------------------------------------------------------
 
 // On some platform vsnprintf() takes va_list by reference and modifies it.
@@ -2214,6 +2632,21 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
     va_end(args_copy);
 }
 
+// Index the lines of base[old_size..new_size]. A trailing '\n' doesn't start a new line until more text is appended.
+void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
+{
+    IM_ASSERT(old_size >= 0 && new_size >= old_size && new_size >= EndOffset);
+    if (old_size == new_size)
+        return;
+    if (EndOffset == 0 || base[EndOffset - 1] == '\n')
+        LineOffsets.push_back(EndOffset);
+    const char* base_end = base + new_size;
+    for (const char* p = base + old_size; (p = (const char*)memchr(p, '\n', (size_t)(base_end - p))) != NULL; )
+        if (++p < base_end)
+            LineOffsets.push_back((int)(p - base));
+    EndOffset = ImMax(EndOffset, new_size);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 // This is currently not as flexible/powerful as it should be and really confusing/spaghetti, mostly because we changed
@@ -2990,11 +3423,14 @@ static void SetCurrentWindow(ImGuiWindow* window)
 // This should have no noticeable visual effect. When the window reappear however, expect new allocation/buffer growth/copy cost.
 void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
 {
+    ImGuiContext& g = *GImGui;
+    g.GcReclaimedBytes += GcCalcTransientWindowBuffersSize(window);
     window->MemoryCompacted = true;
     window->MemoryDrawListIdxCapacity = window->DrawList->IdxBuffer.Capacity;
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
     window->DrawList->ClearFreeMemory();
+    window->DrawListCache.ClearFreeMemory();
     window->DC.ChildWindows.clear();
     window->DC.ItemFlagsStack.clear();
     window->DC.ItemWidthStack.clear();
@@ -3012,6 +3448,156 @@ void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListIdxCapacity = window->MemoryDrawListVtxCapacity = 0;
 }
 
+template<typename T>
+static inline size_t GcCalcVectorCapacity(const ImVector<T>& v)
+{
+    return (size_t)v.Capacity * sizeof(T);
+}
+
+// Reallocate a vector to fit 'new_capacity' elements (at least its current size), keeping its contents. Return the number of bytes freed.
+template<typename T>
+static size_t GcShrinkVector(ImVector<T>& v, int new_capacity)
+{
+    new_capacity = ImMax(new_capacity, v.Size);
+    if (new_capacity >= v.Capacity)
+        return 0;
+    const size_t freed_bytes = (size_t)(v.Capacity - new_capacity) * sizeof(T);
+    ImVector<T> tmp;
+    if (new_capacity > 0)
+    {
+        tmp.reserve(new_capacity);
+        tmp.Size = v.Size;
+        memcpy(tmp.Data, v.Data, (size_t)v.Size * sizeof(T));
+    }
+    v.swap(tmp);
+    return freed_bytes;
+}
+
+// Bytes allocated by the buffers freed by GcCompactTransientWindowBuffers()
+size_t ImGui::GcCalcTransientWindowBuffersSize(ImGuiWindow* window)
+{
+    const ImDrawList* draw_list = window->DrawList;
+    size_t size = GcCalcVectorCapacity(draw_list->CmdBuffer) + GcCalcVectorCapacity(draw_list->IdxBuffer) + GcCalcVectorCapacity(draw_list->VtxBuffer);
+    size += GcCalcVectorCapacity(draw_list->_ClipRectStack) + GcCalcVectorCapacity(draw_list->_TextureIdStack) + GcCalcVectorCapacity(draw_list->_Path);
+    size += GcCalcVectorCapacity(draw_list->_Splitter._Channels);
+    for (int n = 0; n < draw_list->_Splitter._Channels.Size; n++)
+        if (n != draw_list->_Splitter._Current) // Current channel is a copy of CmdBuffer/IdxBuffer
+            size += GcCalcVectorCapacity(draw_list->_Splitter._Channels[n]._CmdBuffer) + GcCalcVectorCapacity(draw_list->_Splitter._Channels[n]._IdxBuffer);
+    if (const ImDrawListDeferred* deferred = draw_list->_Deferred)
+        size += sizeof(ImDrawListDeferred) + GcCalcVectorCapacity(deferred->Cmds) + GcCalcVectorCapacity(deferred->Points) + GcCalcVectorCapacity(deferred->Text);
+    const ImGuiWindowDrawListCache& cache = window->DrawListCache;
+    size += GcCalcVectorCapacity(cache.CmdBuffer) + GcCalcVectorCapacity(cache.IdxBuffer) + GcCalcVectorCapacity(cache.VtxBuffer);
+    size += GcCalcVectorCapacity(window->IDStack);
+    size += GcCalcVectorCapacity(window->DC.ChildWindows) + GcCalcVectorCapacity(window->DC.ItemFlagsStack) + GcCalcVectorCapacity(window->DC.ItemWidthStack);
+    size += GcCalcVectorCapacity(window->DC.TextWrapPosStack) + GcCalcVectorCapacity(window->DC.GroupStack);
+    return size;
+}
+
+static int IMGUI_CDECL LastTimeActiveWindowComparer(const void* lhs, const void* rhs)
+{
+    const ImGuiWindow* const a = *(const ImGuiWindow* const *)lhs;
+    const ImGuiWindow* const b = *(const ImGuiWindow* const *)rhs;
+    return (a->LastTimeActive < b->LastTimeActive) ? -1 : (a->LastTimeActive > b->LastTimeActive) ? +1 : 0;
+}
+
+// Free transient buffers until their total capacity fits in 'budget' bytes (see io.ConfigMemoryCompactBudget), in this order:
+// - compact windows which weren't active last frame, least recently active first.
+// - free the input text state buffers if no input text is using them.
+// - shrink draw list buffers of active windows which are more than twice as large as the contents of their last frame.
+// Called by NewFrame() before windows are submitted again, so draw lists of active windows still hold their last frame.
+void ImGui::GcCompactToMemoryBudget(size_t budget)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiInputTextState& input_text_state = g.InputTextState;
+    size_t total_size = GcCalcVectorCapacity(input_text_state.TextW) + GcCalcVectorCapacity(input_text_state.TextA) + GcCalcVectorCapacity(input_text_state.InitialTextA);
+    total_size += GcCalcVectorCapacity(input_text_state.LineStartsW) + GcCalcVectorCapacity(input_text_state.LineStartsA);
+    const size_t input_text_size = total_size;
+    int inactive_count = 0;
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (window->MemoryCompacted)
+            continue;
+        total_size += GcCalcTransientWindowBuffersSize(window);
+        if (!window->WasActive)
+            inactive_count++;
+    }
+    g.GcMemoryUsage = total_size;
+    if (total_size <= budget)
+        return;
+
+    // Compact least recently active windows first
+    if (inactive_count > 0)
+    {
+        ImGuiWindow** inactive_windows = g.FrameArena.AllocArray<ImGuiWindow*>(inactive_count);
+        inactive_count = 0;
+        for (int i = 0; i != g.Windows.Size; i++)
+            if (!g.Windows[i]->WasActive && !g.Windows[i]->MemoryCompacted)
+                inactive_windows[inactive_count++] = g.Windows[i];
+        ImQsort(inactive_windows, (size_t)inactive_count, sizeof(ImGuiWindow*), LastTimeActiveWindowComparer);
+        for (int i = 0; i < inactive_count && total_size > budget; i++)
+        {
+            const size_t window_size = GcCalcTransientWindowBuffersSize(inactive_windows[i]);
+            GcCompactTransientWindowBuffers(inactive_windows[i]);
+            total_size -= window_size;
+            g.GcCompactedWindowsCount++;
+        }
+    }
+
+    // Input text state is rebuilt when an input text is activated
+    if (total_size > budget && input_text_size > 0 && input_text_state.ID != g.ActiveId && input_text_state.ID != g.ActiveIdPreviousFrame)
+    {
+        input_text_state.ClearFreeMemory();
+        total_size -= input_text_size;
+        g.GcReclaimedBytes += input_text_size;
+    }
+
+    // Shrink over-grown draw list buffers of active windows, keeping some room for growth
+    for (int i = 0; i != g.Windows.Size && total_size > budget; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!window->WasActive)
+            continue;
+        ImDrawList* draw_list = window->DrawList;
+        size_t freed_bytes = 0;
+        if (draw_list->VtxBuffer.Capacity > draw_list->VtxBuffer.Size * 2)
+            freed_bytes += GcShrinkVector(draw_list->VtxBuffer, draw_list->VtxBuffer.Size + draw_list->VtxBuffer.Size / 2);
+        if (draw_list->IdxBuffer.Capacity > draw_list->IdxBuffer.Size * 2)
+            freed_bytes += GcShrinkVector(draw_list->IdxBuffer, draw_list->IdxBuffer.Size + draw_list->IdxBuffer.Size / 2);
+        if (draw_list->CmdBuffer.Capacity > draw_list->CmdBuffer.Size * 2)
+            freed_bytes += GcShrinkVector(draw_list->CmdBuffer, draw_list->CmdBuffer.Size + draw_list->CmdBuffer.Size / 2);
+        if (freed_bytes == 0)
+            continue;
+        draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+        draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+        total_size -= freed_bytes;
+        g.GcReclaimedBytes += freed_bytes;
+        g.GcShrunkWindowsCount++;
+    }
+    g.GcMemoryUsage = total_size;
+}
+
+// Free min/max pyramids of decimated plots which haven't been submitted since 'memory_compact_start_time'.
+void ImGui::GcCompactPlotCaches(float memory_compact_start_time)
+{
+    ImGuiContext& g = *GImGui;
+    const int old_size = g.PlotCaches.Size;
+    for (int n = 0; n < g.PlotCaches.Size; n++)
+        if (g.PlotCaches[n]->LastTimeUsed < memory_compact_start_time)
+        {
+            IM_DELETE(g.PlotCaches[n]);
+            g.PlotCaches.erase(g.PlotCaches.Data + n);
+            n--;
+        }
+    if (g.PlotCaches.Size == old_size)
+        return;
+
+    // Indices of the remaining caches have changed
+    g.PlotCachesById.Clear();
+    for (int n = 0; n < g.PlotCaches.Size; n++)
+        g.PlotCachesById.SetInt(g.PlotCaches[n]->ID, n);
+}
+
 void ImGui::SetActiveID(ImGuiID id, ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
@@ -3252,11 +3838,90 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
-// IM_ALLOC() == ImGui::MemAlloc()
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+// Record an allocation in the call sites table of the context. Sites are searched linearly: this is a debug feature.
+static void TrackAllocation(ImGuiContext* ctx, size_t size, const char* file, int line)
+{
+    ImGuiContext& g = *ctx;
+    if (g.AllocSites.Size == 0)
+        return;
+    const char* name = g.AllocScope ? g.AllocScope : file ? file : "(unknown)";
+    if (g.AllocScope)
+        line = 0;
+    ImGuiAllocSite* site = NULL;
+    for (int n = 0; n < g.AllocSitesCount && site == NULL; n++)
+        if (g.AllocSites[n].Line == line && (g.AllocSites[n].Name == name || strcmp(g.AllocSites[n].Name, name) == 0)) // __FILE__ may be a different pointer in each translation unit
+            site = &g.AllocSites[n];
+    if (site == NULL)
+    {
+        if (g.AllocSitesCount < g.AllocSites.Size - 1)
+        {
+            site = &g.AllocSites[g.AllocSitesCount++];
+            site->Name = name;
+            site->Line = line;
+        }
+        else
+        {
+            // Table is full: the last entry collects everything else
+            site = &g.AllocSites.back();
+            if (g.AllocSitesCount < g.AllocSites.Size)
+            {
+                g.AllocSitesCount++;
+                site->Name = "(other sites)";
+                site->Line = -1;
+            }
+        }
+    }
+    site->Count++;
+    site->Bytes += size;
+    site->CountThisFrame++;
+}
+
+ImGuiAllocScope::ImGuiAllocScope(const char* name)
+{
+    ImGuiContext* ctx = GImGui;
+    BackupName = ctx ? ctx->AllocScope : NULL;
+    if (ctx)
+        ctx->AllocScope = name;
+}
+
+ImGuiAllocScope::~ImGuiAllocScope()
+{
+    if (ImGuiContext* ctx = GImGui)
+        ctx->AllocScope = BackupName;
+}
+#endif
+
+// Allocation counters are also updated by io.ParallelForFn jobs running on other threads (e.g. deferred tessellation)
+static inline void ImAtomicAdd(int* p, int v)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangeAdd((volatile long*)p, (long)v);
+#elif defined(__GNUC__) || defined(__clang__)
+    __sync_fetch_and_add(p, v);
+#else
+    *p += v;
+#endif
+}
+
+// IM_ALLOC() == ImGui::MemAlloc(), or ImGui::MemAllocEx() when IMGUI_ENABLE_ALLOC_TRACKING is defined
 void* ImGui::MemAlloc(size_t size)
 {
+    return MemAllocEx(size, NULL, 0);
+}
+
+void* ImGui::MemAllocEx(size_t size, const char* file, int line)
+{
+    IM_UNUSED(file);
+    IM_UNUSED(line);
     if (ImGuiContext* ctx = GImGui)
-        ctx->IO.MetricsActiveAllocations++;
+    {
+        ImAtomicAdd(&ctx->IO.MetricsActiveAllocations, +1);
+        ImAtomicAdd(&ctx->FrameAllocationsCount, +1);
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+        TrackAllocation(ctx, size, file, line);
+#endif
+    }
     return GImAllocatorAllocFunc(size, GImAllocatorUserData);
 }
 
@@ -3265,10 +3930,66 @@ void ImGui::MemFree(void* ptr)
 {
     if (ptr)
         if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
+            ImAtomicAdd(&ctx->IO.MetricsActiveAllocations, -1);
     return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
 }
 
+// Block header size, rounded so allocations are aligned on 16 bytes relative to the MemAlloc() pointer
+static const size_t IM_FRAME_ARENA_HEADER_SIZE = (sizeof(ImFrameArenaBlock) + 15) & ~(size_t)15;
+
+void* ImFrameArena::Alloc(size_t size)
+{
+    size = (size + 15) & ~(size_t)15;
+    if (Block == NULL || Block->Used + size > Block->Size)
+    {
+        // Double the block size so a frame needs few blocks, and the last one can hold the whole frame
+        size_t block_size = ImMax(size, ImMax(BlockMinSize, Block ? Block->Size * 2 : (size_t)0));
+        ImFrameArenaBlock* block = (ImFrameArenaBlock*)IM_ALLOC(IM_FRAME_ARENA_HEADER_SIZE + block_size);
+        block->Prev = Block;
+        block->Size = block_size;
+        block->Used = 0;
+        Block = block;
+    }
+    void* ptr = (char*)Block + IM_FRAME_ARENA_HEADER_SIZE + Block->Used;
+    Block->Used += size;
+    FrameBytes += size;
+    return ptr;
+}
+
+void ImFrameArena::Reset()
+{
+    LastFrameBytes = FrameBytes;
+    FrameBytes = 0;
+    if (Block == NULL)
+        return;
+
+    // Only keep the last block: it is the largest one and at least half the size of what the frame used
+    while (ImFrameArenaBlock* prev = Block->Prev)
+    {
+        Block->Prev = prev->Prev;
+        IM_FREE(prev);
+    }
+
+    // Release a block much larger than what the frame used (e.g. after pasting a large clipboard)
+    if (Block->Size > BlockMinSize && LastFrameBytes * 4 < Block->Size)
+    {
+        IM_FREE(Block);
+        Block = NULL;
+        return;
+    }
+    Block->Used = 0;
+}
+
+void ImFrameArena::ClearFreeMemory()
+{
+    while (ImFrameArenaBlock* block = Block)
+    {
+        Block = block->Prev;
+        IM_FREE(block);
+    }
+    FrameBytes = LastFrameBytes = 0;
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -3488,6 +4209,7 @@ static bool IsWindowActiveAndVisible(ImGuiWindow* window)
 static void ImGui::UpdateMouseInputs()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateMouseInputs");
 
     // Round mouse position to avoid spreading non-rounded position (e.g. UpdateManualResize doesn't support them well)
     if (IsMousePosValid(&g.IO.MousePos))
@@ -3668,6 +4390,7 @@ void ImGui::UpdateTabFocus()
 void ImGui::UpdateHoveredWindowAndCaptureFlags()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("UpdateHoveredWindowAndCaptureFlags");
 
     // Find the window hovered by mouse:
     // - Child windows can extend beyond the limit of their parent so we need to derive HoveredRootWindow from HoveredWindow.
@@ -3738,6 +4461,7 @@ void ImGui::NewFrame()
 {
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("NewFrame");
 
 #ifdef IMGUI_ENABLE_TEST_ENGINE
     ImGuiTestEngineHook_PreNewFrame(&g);
@@ -3746,6 +4470,19 @@ void ImGui::NewFrame()
     // Check and assert for various common IO and Configuration mistakes
     ErrorCheckNewFrameSanityChecks();
 
+    // Release the temporary memory of the previous frame
+    g.IO.MetricsFrameAllocations = g.FrameAllocationsCount;
+    g.IO.MetricsFrameArenaBytes = (int)g.FrameArena.FrameBytes;
+    g.FrameAllocationsCount = 0;
+    g.FrameArena.Reset();
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+    for (int n = 0; n < g.AllocSitesCount; n++)
+    {
+        g.AllocSites[n].CountLastFrame = g.AllocSites[n].CountThisFrame;
+        g.AllocSites[n].CountThisFrame = 0;
+    }
+#endif
+
     // Load settings on first frame, save settings when modified (after a delay)
     UpdateSettings();
 
@@ -3766,6 +4503,7 @@ void ImGui::NewFrame()
     g.IO.Fonts->Locked = true;
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
+    g.StyleHash = ImHashData(&g.Style, sizeof(g.Style));
     g.DrawListSharedData.ClipRectFullscreen = ImVec4(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
     g.DrawListSharedData.CurveTessellationTol = g.Style.CurveTessellationTol;
     g.DrawListSharedData.SetCircleSegmentMaxError(g.Style.CircleSegmentMaxError);
@@ -3776,6 +4514,19 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    g.DrawListSharedData.BuffersShrinkFrames = g.IO.ConfigDrawListsShrinkFrames;
+    g.DrawListSharedData.BuffersPreSize = g.IO.ConfigDrawListsPreSize;
+    if (g.IO.ConfigTextCacheBudget > 0)
+    {
+        g.DrawListSharedData.TextCache = &g.TextCache;
+        g.TextCache.GarbageCollect(g.IO.ConfigTextCacheBudget);
+    }
+    else
+    {
+        g.DrawListSharedData.TextCache = NULL;
+        if (g.TextCache.Entries.Size > 0)
+            g.TextCache.Clear();
+    }
 
     g.BackgroundDrawList.Clear();
     g.BackgroundDrawList.PushTextureID(g.IO.Fonts->TexID);
@@ -3872,8 +4623,9 @@ void ImGui::NewFrame()
     UpdateTabFocus();
 
     // Mark all windows as not visible and compact unused memory.
+    g.WindowsHitGridValid = false;
     IM_ASSERT(g.WindowsFocusOrder.Size == g.Windows.Size);
-    const float memory_compact_start_time = (g.IO.ConfigWindowsMemoryCompactTimer >= 0.0f) ? (float)g.Time - g.IO.ConfigWindowsMemoryCompactTimer : FLT_MAX;
+    const float memory_compact_start_time = (g.IO.ConfigWindowsMemoryCompactTimer >= 0.0f) ? (float)g.Time - g.IO.ConfigWindowsMemoryCompactTimer : -FLT_MAX;
     for (int i = 0; i != g.Windows.Size; i++)
     {
         ImGuiWindow* window = g.Windows[i];
@@ -3886,6 +4638,10 @@ void ImGui::NewFrame()
         if (!window->WasActive && !window->MemoryCompacted && window->LastTimeActive < memory_compact_start_time)
             GcCompactTransientWindowBuffers(window);
     }
+    if (g.IO.ConfigMemoryCompactBudget > 0)
+        GcCompactToMemoryBudget((size_t)g.IO.ConfigMemoryCompactBudget);
+    if (g.PlotCaches.Size > 0)
+        GcCompactPlotCaches(memory_compact_start_time);
 
     // Closing the focused window restore focus to the first active root window in descending z-order
     if (g.NavWindow && !g.NavWindow->WasActive)
@@ -3943,6 +4699,24 @@ void ImGui::Initialize(ImGuiContext* context)
     ImGuiContext& g = *context;
     IM_ASSERT(!g.Initialized && !g.SettingsLoaded);
 
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+    // Allocate the call sites table first (it never grows, so recording an allocation never allocates)
+    g.AllocSites.resize(IMGUI_ALLOC_SITES_CAPACITY);
+    memset(g.AllocSites.Data, 0, (size_t)g.AllocSites.size_in_bytes());
+    g.AllocSitesCount = 0;
+#endif
+
+    // Add .ini handle for the ID hash function. Registered first so it is written/read before any entry storing ImGuiID values.
+    {
+        ImGuiSettingsHandler ini_handler;
+        ini_handler.TypeName = "Hash";
+        ini_handler.TypeHash = ImHashStr("Hash");
+        ini_handler.ReadInitFn = HashSettingsHandler_ReadInit;
+        ini_handler.ReadOpenFn = HashSettingsHandler_ReadOpen;
+        ini_handler.WriteAllFn = HashSettingsHandler_WriteAll;
+        g.SettingsHandlers.push_back(ini_handler);
+    }
+
     // Add .ini handle for ImGuiWindow type
     {
         ImGuiSettingsHandler ini_handler;
@@ -4005,10 +4779,14 @@ void ImGui::Shutdown(ImGuiContext* context)
         IM_DELETE(g.Windows[i]);
     g.Windows.clear();
     g.WindowsFocusOrder.clear();
-    g.WindowsTempSortBuffer.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.WindowsById.Clear();
+    g.WindowsLookupCache.clear();
+    g.WindowsLookupHint = NULL;
+    g.WindowsHitGrid.ClearFreeMemory();
+    g.WindowsHitGridWindows.clear();
+    g.WindowsHitGridValid = false;
     g.NavWindow = NULL;
     g.HoveredWindow = g.HoveredRootWindow = NULL;
     g.ActiveIdWindow = g.ActiveIdPreviousFrameWindow = NULL;
@@ -4019,8 +4797,11 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.OpenPopupStack.clear();
     g.BeginPopupStack.clear();
     g.DrawDataBuilder.ClearFreeMemory();
+    g.DrawListsToFlush.clear();
     g.BackgroundDrawList.ClearFreeMemory();
     g.ForegroundDrawList.ClearFreeMemory();
+    g.DrawListSharedData.TextCache = NULL;
+    g.TextCache.Clear();
 
     g.TabBars.Clear();
     g.CurrentTabBarStack.clear();
@@ -4028,6 +4809,16 @@ void ImGui::Shutdown(ImGuiContext* context)
 
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
+    g.FrameArena.ClearFreeMemory();
+    g.AllocSites.clear();
+    g.AllocSitesCount = 0;
+    for (int i = 0; i < g.PlotCaches.Size; i++)
+        IM_DELETE(g.PlotCaches[i]);
+    g.PlotCaches.clear();
+    g.PlotCachesById.Clear();
+    for (int i = 0; i < g.ColorPickerMeshes.Size; i++)
+        IM_DELETE(g.ColorPickerMeshes[i]);
+    g.ColorPickerMeshes.clear();
     g.InputTextState.ClearFreeMemory();
 
     g.SettingsWindows.clear();
@@ -4058,9 +4849,9 @@ static int IMGUI_CDECL ChildWindowComparer(const void* lhs, const void* rhs)
     return (a->BeginOrderWithinParent - b->BeginOrderWithinParent);
 }
 
-static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window)
+static void AddWindowToSortBuffer(ImGuiWindow** out_sorted_windows, int* out_sorted_count, ImGuiWindow* window)
 {
-    out_sorted_windows->push_back(window);
+    out_sorted_windows[(*out_sorted_count)++] = window;
     if (window->Active)
     {
         int count = window->DC.ChildWindows.Size;
@@ -4070,7 +4861,7 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
         {
             ImGuiWindow* child = window->DC.ChildWindows[i];
             if (child->Active)
-                AddWindowToSortBuffer(out_sorted_windows, child);
+                AddWindowToSortBuffer(out_sorted_windows, out_sorted_count, child);
         }
     }
 }
@@ -4080,6 +4871,9 @@ static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* d
     if (draw_list->CmdBuffer.empty())
         return;
 
+    // Generate remaining deferred primitives (normally done in parallel at the beginning of Render(), see FlushDeferredDrawLists())
+    draw_list->_FlushDeferred();
+
     // Remove trailing command if unused
     ImDrawCmd& last_cmd = draw_list->CmdBuffer.back();
     if (last_cmd.ElemCount == 0 && last_cmd.UserCallback == NULL)
@@ -4117,60 +4911,349 @@ static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* d
     out_list->push_back(draw_list);
 }
 
-static void AddWindowToDrawData(ImVector<ImDrawList*>* out_render_list, ImGuiWindow* window)
+static void FlushDeferredDrawListJob(void* job_data, int index)
+{
+    ImDrawList** draw_lists = (ImDrawList**)job_data;
+    draw_lists[index]->_FlushDeferred();
+}
+
+// Tessellate primitives recorded by window draw lists with ImDrawListFlags_DeferTessellation.
+// Each draw list only writes into its own buffers, so they are dispatched as independent jobs to io.ParallelForFn.
+static void FlushDeferredDrawLists()
+{
+    ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("FlushDeferredDrawLists");
+    g.DrawListsToFlush.resize(0);
+    for (int n = 0; n != g.Windows.Size; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        ImDrawListDeferred* deferred = window->DrawList->_Deferred;
+        if (deferred && deferred->Cmds.Size > 0 && IsWindowActiveAndVisible(window))
+            g.DrawListsToFlush.push_back(window->DrawList);
+    }
+    if (g.DrawListsToFlush.Size == 0)
+        return;
+    if (g.IO.ParallelForFn != NULL && g.DrawListsToFlush.Size > 1)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, g.DrawListsToFlush.Size, FlushDeferredDrawListJob, g.DrawListsToFlush.Data);
+    else
+        for (int n = 0; n < g.DrawListsToFlush.Size; n++)
+            FlushDeferredDrawListJob(g.DrawListsToFlush.Data, n);
+}
+
+static void AddWindowToDrawData(ImVector<ImDrawList*>* out_render_list, ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    g.IO.MetricsRenderWindows++;
+    if (window->Flags & ImGuiWindowFlags_CacheContents)
+    {
+        // Display retained output instead of what was submitted this frame (decorations only), see ImGuiWindowDrawListCache
+        ImGuiWindowDrawListCache& cache = window->DrawListCache;
+        if (cache.Hit && !cache.Swapped)
+        {
+            cache.Swap(&window->DrawListInst);
+            cache.Swapped = true;
+        }
+        cache.RenderedFrame = g.FrameCount;
+    }
+    AddDrawListToDrawData(out_render_list, window->DrawList);
+    for (int i = 0; i < window->DC.ChildWindows.Size; i++)
+    {
+        ImGuiWindow* child = window->DC.ChildWindows[i];
+        if (IsWindowActiveAndVisible(child)) // clipped children may have been marked not active
+            AddWindowToDrawData(out_render_list, child);
+    }
+}
+
+// Layer is locked for the root window, however child windows may use a different viewport (e.g. extruding menu)
+static void AddRootWindowToDrawData(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("AddRootWindowToDrawData");
+    int layer = (window->Flags & ImGuiWindowFlags_Tooltip) ? 1 : 0;
+    AddWindowToDrawData(&g.DrawDataBuilder.Layers[layer], window);
+}
+
+void ImDrawDataBuilder::FlattenIntoSingleLayer()
+{
+    IMGUI_PROFILER_ZONE("FlattenIntoSingleLayer");
+    int n = Layers[0].Size;
+    int size = n;
+    for (int i = 1; i < IM_ARRAYSIZE(Layers); i++)
+        size += Layers[i].Size;
+    Layers[0].resize(size);
+    for (int layer_n = 1; layer_n < IM_ARRAYSIZE(Layers); layer_n++)
+    {
+        ImVector<ImDrawList*>& layer = Layers[layer_n];
+        if (layer.empty())
+            continue;
+        memcpy(&Layers[0][n], &layer[0], layer.Size * sizeof(ImDrawList*));
+        n += layer.Size;
+        layer.resize(0);
+    }
+}
+
+static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* draw_data)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    draw_data->Valid = true;
+    draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
+    draw_data->CmdListsCount = draw_lists->Size;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->DisplayPos = ImVec2(0.0f, 0.0f);
+    draw_data->DisplaySize = io.DisplaySize;
+    draw_data->FramebufferScale = io.DisplayFramebufferScale;
+    for (int n = 0; n < draw_lists->Size; n++)
+    {
+        draw_data->TotalVtxCount += draw_lists->Data[n]->VtxBuffer.Size;
+        draw_data->TotalIdxCount += draw_lists->Data[n]->IdxBuffer.Size;
+    }
+}
+
+struct ImDrawDataArenaJobData
+{
+    ImDrawData*     DrawData;
+    const int*      ListOffsets;
+    bool*           CmdUnclipped;   // NULL when not merging commands
+};
+
+// Compute the lowest and highest of 'count' indices (count > 0). With 16-bit indices, SSE2/NEON process 8 indices at a time
+// (SSE2 only has signed 16-bit min/max, so we flip the sign bit of the values).
+static void ImDrawIdxMinMax(const ImDrawIdx* idx, unsigned int count, unsigned int* out_min, unsigned int* out_max)
+{
+    unsigned int n = 0;
+    unsigned int idx_min = idx[0], idx_max = idx[0];
+#if defined(IMGUI_ENABLE_SSE)
+    if (sizeof(ImDrawIdx) == 2 && count >= 8)
+    {
+        const __m128i v_sign = _mm_set1_epi16((short)0x8000);
+        __m128i v_min = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)idx), v_sign);
+        __m128i v_max = v_min;
+        for (n = 8; n + 8 <= count; n += 8)
+        {
+            const __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(idx + n)), v_sign);
+            v_min = _mm_min_epi16(v_min, v);
+            v_max = _mm_max_epi16(v_max, v);
+        }
+        v_min = _mm_min_epi16(v_min, _mm_srli_si128(v_min, 8));
+        v_min = _mm_min_epi16(v_min, _mm_srli_si128(v_min, 4));
+        v_min = _mm_min_epi16(v_min, _mm_srli_si128(v_min, 2));
+        v_max = _mm_max_epi16(v_max, _mm_srli_si128(v_max, 8));
+        v_max = _mm_max_epi16(v_max, _mm_srli_si128(v_max, 4));
+        v_max = _mm_max_epi16(v_max, _mm_srli_si128(v_max, 2));
+        idx_min = ((unsigned int)_mm_cvtsi128_si32(v_min) & 0xFFFF) ^ 0x8000;
+        idx_max = ((unsigned int)_mm_cvtsi128_si32(v_max) & 0xFFFF) ^ 0x8000;
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    if (sizeof(ImDrawIdx) == 2 && count >= 8)
+    {
+        uint16x8_t v_min = vld1q_u16((const uint16_t*)(const void*)idx);
+        uint16x8_t v_max = v_min;
+        for (n = 8; n + 8 <= count; n += 8)
+        {
+            const uint16x8_t v = vld1q_u16((const uint16_t*)(const void*)(idx + n));
+            v_min = vminq_u16(v_min, v);
+            v_max = vmaxq_u16(v_max, v);
+        }
+        idx_min = vminvq_u16(v_min);
+        idx_max = vmaxvq_u16(v_max);
+    }
+#endif
+    for (; n < count; n++)
+    {
+        idx_min = ImMin(idx_min, (unsigned int)idx[n]);
+        idx_max = ImMax(idx_max, (unsigned int)idx[n]);
+    }
+    *out_min = idx_min;
+    *out_max = idx_max;
+}
+
+// Return true if no vertex of the command is outside of its clip rectangle.
+// Rather than following every index, we test the range of vertices between the lowest and highest index of the command (conservative, but linear).
+static bool IsDrawCmdUnclipped(const ImDrawList* draw_list, const ImDrawCmd* cmd)
+{
+    if (cmd->ElemCount == 0)
+        return true;
+    unsigned int idx_min, idx_max;
+    ImDrawIdxMinMax(draw_list->IdxBuffer.Data + cmd->IdxOffset, cmd->ElemCount, &idx_min, &idx_max);
+    const ImVec4 clip_rect = cmd->ClipRect;
+    const ImDrawVert* vtx_end = draw_list->VtxBuffer.Data + cmd->VtxOffset + idx_max + 1;
+    for (const ImDrawVert* vtx = draw_list->VtxBuffer.Data + cmd->VtxOffset + idx_min; vtx < vtx_end; vtx++)
+    {
+        const ImVec2 pos = vtx->pos;
+        if (pos.x < clip_rect.x || pos.y < clip_rect.y || pos.x > clip_rect.z || pos.y > clip_rect.w)
+            return false;
+    }
+    return true;
+}
+
+// Copy the commands of a draw list into the arena (and check which ones are unclipped when merging commands).
+static void SetupDrawDataArenaCommandsJob(void* job_data, int list_n)
+{
+    const ImDrawDataArenaJobData* data = (const ImDrawDataArenaJobData*)job_data;
+    ImDrawData* draw_data = data->DrawData;
+    const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+    const int* offsets = &data->ListOffsets[list_n * 3];
+    ImDrawCmd* cmd_dst = draw_data->ArenaCmdBuffer + offsets[0];
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++, cmd_dst++)
+    {
+        *cmd_dst = draw_list->CmdBuffer.Data[cmd_n];
+        cmd_dst->VtxOffset += (unsigned int)offsets[1];
+        cmd_dst->IdxOffset += (unsigned int)offsets[2];
+    }
+    if (data->CmdUnclipped != NULL)
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd* cmd = &draw_list->CmdBuffer.Data[cmd_n];
+            data->CmdUnclipped[offsets[0] + cmd_n] = (cmd->UserCallback == NULL && IsDrawCmdUnclipped(draw_list, cmd));
+        }
+}
+
+// Copy the vertices and indices of a draw list into the arena.
+// The arena may be write-only memory provided by io.DrawDataArenaAllocFn, so indices of merged commands are rebased while copying them:
+// MergeDrawDataArenaCommands() sets the VtxOffset of a merged arena command to the one of the command it was merged into.
+static void SetupDrawDataArenaJob(void* job_data, int list_n)
+{
+    const ImDrawDataArenaJobData* data = (const ImDrawDataArenaJobData*)job_data;
+    ImDrawData* draw_data = data->DrawData;
+    const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+    const int* offsets = &data->ListOffsets[list_n * 3];
+    const unsigned int vtx_offset = (unsigned int)offsets[1];
+    const unsigned int idx_offset = (unsigned int)offsets[2];
+    memcpy(draw_data->ArenaVtxBuffer + vtx_offset, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+    if (data->CmdUnclipped == NULL)
+    {
+        memcpy(draw_data->ArenaIdxBuffer + idx_offset, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        return;
+    }
+    const ImDrawCmd* cmd_arena = draw_data->ArenaCmdBuffer + offsets[0];
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++, cmd_arena++)
+    {
+        const ImDrawCmd* cmd = &draw_list->CmdBuffer.Data[cmd_n];
+        const ImDrawIdx* idx_src = draw_list->IdxBuffer.Data + cmd->IdxOffset;
+        ImDrawIdx* idx_dst = draw_data->ArenaIdxBuffer + idx_offset + cmd->IdxOffset;
+        if (const ImDrawIdx vtx_delta = (ImDrawIdx)(cmd->VtxOffset + vtx_offset - cmd_arena->VtxOffset))
+            for (const ImDrawIdx* idx_end = idx_src + cmd->ElemCount; idx_src < idx_end; idx_src++, idx_dst++)
+                *idx_dst = (ImDrawIdx)(*idx_src + vtx_delta);
+        else
+            memcpy(idx_dst, idx_src, (size_t)cmd->ElemCount * sizeof(ImDrawIdx));
+    }
+}
+
+// Merge consecutive arena commands of different draw lists (see io.ConfigDrawDataMergeCommands).
+// Indices of the draw lists follow each other in the arena, so a command may be extended over the next one if they use the same texture and
+// either the same clip rectangle, or clip rectangles which don't clip anything (then the union of both is used).
+// Only the arena commands are touched: a merged command keeps its IdxOffset but takes the VtxOffset of the command extended, and
+// SetupDrawDataArenaJob() rebases its indices accordingly when copying them, which requires the difference to fit in ImDrawIdx.
+static int MergeDrawDataArenaCommands(ImDrawData* draw_data, const int* list_offsets, const bool* cmd_unclipped)
 {
-    ImGuiContext& g = *GImGui;
-    g.IO.MetricsRenderWindows++;
-    AddDrawListToDrawData(out_render_list, window->DrawList);
-    for (int i = 0; i < window->DC.ChildWindows.Size; i++)
+    IMGUI_PROFILER_ZONE("MergeDrawDataArenaCommands");
+    int merged_count = 0;
+    ImDrawCmd* head_cmd = NULL;
+    bool head_unclipped = false;
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
     {
-        ImGuiWindow* child = window->DC.ChildWindows[i];
-        if (IsWindowActiveAndVisible(child)) // clipped children may have been marked not active
-            AddWindowToDrawData(out_render_list, child);
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        const int cmd_offset = list_offsets[list_n * 3 + 0];
+        const unsigned int list_vtx_end = (unsigned int)(list_offsets[list_n * 3 + 1] + draw_list->VtxBuffer.Size);
+        for (int cmd_n = cmd_offset; cmd_n < cmd_offset + draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            ImDrawCmd* cmd = &draw_data->ArenaCmdBuffer[cmd_n];
+            if (cmd->UserCallback != NULL)
+            {
+                head_cmd = NULL;
+                continue;
+            }
+            if (cmd->ElemCount == 0)
+                continue;
+            if (head_cmd != NULL && head_cmd->TextureId == cmd->TextureId && head_cmd->IdxOffset + head_cmd->ElemCount == cmd->IdxOffset)
+            {
+                const bool same_clip_rect = (memcmp(&head_cmd->ClipRect, &cmd->ClipRect, sizeof(ImVec4)) == 0);
+                const bool fits_in_idx = (sizeof(ImDrawIdx) > 2 || list_vtx_end - head_cmd->VtxOffset <= (1 << 16));
+                if (fits_in_idx && (same_clip_rect || (head_unclipped && cmd_unclipped[cmd_n])))
+                {
+                    if (!same_clip_rect)
+                    {
+                        head_cmd->ClipRect.x = ImMin(head_cmd->ClipRect.x, cmd->ClipRect.x);
+                        head_cmd->ClipRect.y = ImMin(head_cmd->ClipRect.y, cmd->ClipRect.y);
+                        head_cmd->ClipRect.z = ImMax(head_cmd->ClipRect.z, cmd->ClipRect.z);
+                        head_cmd->ClipRect.w = ImMax(head_cmd->ClipRect.w, cmd->ClipRect.w);
+                    }
+                    head_cmd->ElemCount += cmd->ElemCount;
+                    head_unclipped &= cmd_unclipped[cmd_n];
+                    cmd->VtxOffset = head_cmd->VtxOffset;
+                    cmd->ElemCount = 0;
+                    merged_count++;
+                    continue;
+                }
+            }
+            head_cmd = cmd;
+            head_unclipped = cmd_unclipped[cmd_n];
+        }
     }
+    return merged_count;
 }
 
-// Layer is locked for the root window, however child windows may use a different viewport (e.g. extruding menu)
-static void AddRootWindowToDrawData(ImGuiWindow* window)
+// Copy vertices/indices/commands of all draw lists into single buffers, see ImGuiBackendFlags_RendererHasDrawDataArena.
+// Offsets of each draw list are known upfront, so they are dispatched as independent jobs to io.ParallelForFn.
+static void SetupDrawDataArena(ImDrawData* draw_data)
 {
     ImGuiContext& g = *GImGui;
-    int layer = (window->Flags & ImGuiWindowFlags_Tooltip) ? 1 : 0;
-    AddWindowToDrawData(&g.DrawDataBuilder.Layers[layer], window);
-}
+    IMGUI_PROFILER_ZONE("SetupDrawDataArena");
+    IM_ASSERT((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) && "ImGuiBackendFlags_RendererHasDrawDataArena requires ImGuiBackendFlags_RendererHasVtxOffset.");
+    ImDrawDataBuilder& builder = g.DrawDataBuilder;
 
-void ImDrawDataBuilder::FlattenIntoSingleLayer()
-{
-    int n = Layers[0].Size;
-    int size = n;
-    for (int i = 1; i < IM_ARRAYSIZE(Layers); i++)
-        size += Layers[i].Size;
-    Layers[0].resize(size);
-    for (int layer_n = 1; layer_n < IM_ARRAYSIZE(Layers); layer_n++)
+    int cmd_count = 0;
+    builder.ArenaListOffsets.resize(draw_data->CmdListsCount * 3);
+    for (int n = 0, vtx_count = 0, idx_count = 0; n < draw_data->CmdListsCount; n++)
     {
-        ImVector<ImDrawList*>& layer = Layers[layer_n];
-        if (layer.empty())
-            continue;
-        memcpy(&Layers[0][n], &layer[0], layer.Size * sizeof(ImDrawList*));
-        n += layer.Size;
-        layer.resize(0);
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        builder.ArenaListOffsets[n * 3 + 0] = cmd_count;
+        builder.ArenaListOffsets[n * 3 + 1] = vtx_count;
+        builder.ArenaListOffsets[n * 3 + 2] = idx_count;
+        cmd_count += draw_list->CmdBuffer.Size;
+        vtx_count += draw_list->VtxBuffer.Size;
+        idx_count += draw_list->IdxBuffer.Size;
     }
-}
 
-static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* draw_data)
-{
-    ImGuiIO& io = ImGui::GetIO();
-    draw_data->Valid = true;
-    draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
-    draw_data->CmdListsCount = draw_lists->Size;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
-    draw_data->DisplayPos = ImVec2(0.0f, 0.0f);
-    draw_data->DisplaySize = io.DisplaySize;
-    draw_data->FramebufferScale = io.DisplayFramebufferScale;
-    for (int n = 0; n < draw_lists->Size; n++)
+    void* user_vtx_buffer = NULL;
+    void* user_idx_buffer = NULL;
+    if (g.IO.DrawDataArenaAllocFn != NULL && g.IO.DrawDataArenaAllocFn(g.IO.DrawDataArenaUserData, draw_data->TotalVtxCount, draw_data->TotalIdxCount, &user_vtx_buffer, &user_idx_buffer))
     {
-        draw_data->TotalVtxCount += draw_lists->Data[n]->VtxBuffer.Size;
-        draw_data->TotalIdxCount += draw_lists->Data[n]->IdxBuffer.Size;
+        draw_data->ArenaVtxBuffer = (ImDrawVert*)user_vtx_buffer;
+        draw_data->ArenaIdxBuffer = (ImDrawIdx*)user_idx_buffer;
     }
+    else
+    {
+        builder.ArenaVtxBuffer.resize(ImMax(draw_data->TotalVtxCount, 1));
+        builder.ArenaIdxBuffer.resize(ImMax(draw_data->TotalIdxCount, 1));
+        draw_data->ArenaVtxBuffer = builder.ArenaVtxBuffer.Data;
+        draw_data->ArenaIdxBuffer = builder.ArenaIdxBuffer.Data;
+    }
+    IM_ASSERT(draw_data->ArenaVtxBuffer != NULL && draw_data->ArenaIdxBuffer != NULL);
+    builder.ArenaCmdBuffer.resize(ImMax(cmd_count, 1));
+    draw_data->ArenaCmdBuffer = builder.ArenaCmdBuffer.Data;
+    draw_data->ArenaCmdCount = cmd_count;
+
+    const bool merge_commands = g.IO.ConfigDrawDataMergeCommands;
+    if (merge_commands)
+        builder.ArenaCmdUnclipped.resize(ImMax(cmd_count, 1));
+
+    // Commands are set up and merged first, so that vertices/indices are only ever written to the arena.
+    ImDrawDataArenaJobData job_data = { draw_data, builder.ArenaListOffsets.Data, merge_commands ? builder.ArenaCmdUnclipped.Data : NULL };
+    const bool parallel = (g.IO.ParallelForFn != NULL && draw_data->CmdListsCount > 1);
+    if (parallel)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, draw_data->CmdListsCount, SetupDrawDataArenaCommandsJob, &job_data);
+    else
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            SetupDrawDataArenaCommandsJob(&job_data, n);
+
+    builder.ArenaCmdMergedCount = merge_commands ? MergeDrawDataArenaCommands(draw_data, builder.ArenaListOffsets.Data, builder.ArenaCmdUnclipped.Data) : 0;
+
+    if (parallel)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, draw_data->CmdListsCount, SetupDrawDataArenaJob, &job_data);
+    else
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            SetupDrawDataArenaJob(&job_data, n);
 }
 
 // When using this function it is sane to ensure that float are perfectly rounded to integer values, to that e.g. (int)(max.x-min.x) in user's render produce correct result.
@@ -4197,6 +5280,7 @@ void ImGui::EndFrame()
     // Don't process EndFrame() multiple times.
     if (g.FrameCountEnded == g.FrameCount)
         return;
+    IMGUI_PROFILER_ZONE("EndFrame");
     IM_ASSERT(g.WithinFrameScope && "Forgot to call ImGui::NewFrame()?");
 
     ErrorCheckEndFrameSanityChecks();
@@ -4243,21 +5327,28 @@ void ImGui::EndFrame()
 
     // Sort the window list so that all child windows are after their parent
     // We cannot do that on FocusWindow() because children may not exist yet
-    g.WindowsTempSortBuffer.resize(0);
-    g.WindowsTempSortBuffer.reserve(g.Windows.Size);
-    for (int i = 0; i != g.Windows.Size; i++)
     {
-        ImGuiWindow* window = g.Windows[i];
-        if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
-            continue;
-        AddWindowToSortBuffer(&g.WindowsTempSortBuffer, window);
-    }
+        IMGUI_PROFILER_ZONE("SortWindows");
+        ImGuiWindow** sorted_windows = g.FrameArena.AllocArray<ImGuiWindow*>(g.Windows.Size);
+        int sorted_count = 0;
+        for (int i = 0; i != g.Windows.Size; i++)
+        {
+            ImGuiWindow* window = g.Windows[i];
+            if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
+                continue;
+            AddWindowToSortBuffer(sorted_windows, &sorted_count, window);
+        }
 
-    // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
-    IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
-    g.Windows.swap(g.WindowsTempSortBuffer);
+        // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
+        IM_ASSERT(g.Windows.Size == sorted_count);
+        if (g.Windows.Size == sorted_count)
+            memcpy(g.Windows.Data, sorted_windows, (size_t)sorted_count * sizeof(ImGuiWindow*));
+    }
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
+    // Windows rectangles and display order are final until the next NewFrame(), index them for FindHoveredWindow()
+    BuildWindowsHitGrid();
+
     // Unlock font atlas
     g.IO.Fonts->Locked = false;
 
@@ -4271,12 +5362,14 @@ void ImGui::Render()
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
+    IMGUI_PROFILER_ZONE("Render");
 
     if (g.FrameCountEnded != g.FrameCount)
         EndFrame();
     g.FrameCountRendered = g.FrameCount;
     g.IO.MetricsRenderWindows = 0;
     g.DrawDataBuilder.Clear();
+    FlushDeferredDrawLists();
 
     // Add background ImDrawList
     if (!g.BackgroundDrawList.VtxBuffer.empty())
@@ -4307,8 +5400,14 @@ void ImGui::Render()
 
     // Setup ImDrawData structure for end-user
     SetupDrawData(&g.DrawDataBuilder.Layers[0], &g.DrawData);
+    g.DrawDataBuilder.ArenaCmdMergedCount = 0;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena)
+        SetupDrawDataArena(&g.DrawData);
     g.IO.MetricsRenderVertices = g.DrawData.TotalVtxCount;
     g.IO.MetricsRenderIndices = g.DrawData.TotalIdxCount;
+    g.IO.MetricsRenderDrawCalls = -g.DrawDataBuilder.ArenaCmdMergedCount;
+    for (int n = 0; n < g.DrawData.CmdListsCount; n++)
+        g.IO.MetricsRenderDrawCalls += g.DrawData.CmdLists[n]->CmdBuffer.Size;
 
     // (Legacy) Call the Render callback function. The current prefer way is to let the user retrieve GetDrawData() and call the render function themselves.
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
@@ -4333,7 +5432,8 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    ImFontTextCacheEntry* cache_entry = g.DrawListSharedData.TextCache ? g.DrawListSharedData.TextCache->GetEntry(font, font_size, wrap_width, text, text_display_end) : NULL;
+    ImVec2 text_size = cache_entry ? cache_entry->TextSize : font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     text_size.x = IM_FLOOR(text_size.x + 0.95f);
@@ -4345,6 +5445,50 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
 // FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
 // with SetWindowPos() and not SetNextWindowPos() will have that rectangle lagging by a frame at the time FindHoveredWindow() is
 // called, aka before the next Begin(). Moving window isn't affected.
+static void CalcWindowsHoverPadding(ImVec2* out_padding_regular, ImVec2* out_padding_for_resize_from_edges)
+{
+    ImGuiContext& g = *GImGui;
+    *out_padding_regular = g.Style.TouchExtraPadding;
+    *out_padding_for_resize_from_edges = g.IO.ConfigWindowsResizeFromEdges ? ImMax(g.Style.TouchExtraPadding, ImVec2(WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS, WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS)) : g.Style.TouchExtraPadding;
+}
+
+static bool IsWindowHoverable(ImGuiWindow* window)
+{
+    return window->Active && !window->Hidden && !(window->Flags & ImGuiWindowFlags_NoMouseInputs);
+}
+
+static ImRect GetWindowHoverRect(ImGuiWindow* window, const ImVec2& padding_regular, const ImVec2& padding_for_resize_from_edges)
+{
+    // Using the clipped AABB, a child window will typically be clipped by its parent (not always)
+    ImRect bb(window->OuterRectClipped);
+    if (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize))
+        bb.Expand(padding_regular);
+    else
+        bb.Expand(padding_for_resize_from_edges);
+    return bb;
+}
+
+// Index hoverable windows rectangles so FindHoveredWindow() only tests the windows overlapping the mouse position.
+// The grid stays valid until NewFrame() resets windows or the display order changes (e.g. FocusWindow() from NavUpdate()).
+static void BuildWindowsHitGrid()
+{
+    ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("BuildWindowsHitGrid");
+    CalcWindowsHoverPadding(&g.WindowsHitGridPadding[0], &g.WindowsHitGridPadding[1]);
+    g.WindowsHitGrid.Clear();
+    g.WindowsHitGridWindows.resize(0);
+    for (int i = 0; i < g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (!IsWindowHoverable(window))
+            continue;
+        g.WindowsHitGrid.Add(GetWindowHoverRect(window, g.WindowsHitGridPadding[0], g.WindowsHitGridPadding[1]));
+        g.WindowsHitGridWindows.push_back(window);
+    }
+    g.WindowsHitGrid.Build();
+    g.WindowsHitGridValid = true;
+}
+
 static void FindHoveredWindow()
 {
     ImGuiContext& g = *GImGui;
@@ -4353,30 +5497,37 @@ static void FindHoveredWindow()
     if (g.MovingWindow && !(g.MovingWindow->Flags & ImGuiWindowFlags_NoMouseInputs))
         hovered_window = g.MovingWindow;
 
-    ImVec2 padding_regular = g.Style.TouchExtraPadding;
-    ImVec2 padding_for_resize_from_edges = g.IO.ConfigWindowsResizeFromEdges ? ImMax(g.Style.TouchExtraPadding, ImVec2(WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS, WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS)) : padding_regular;
-    for (int i = g.Windows.Size - 1; i >= 0; i--)
-    {
-        ImGuiWindow* window = g.Windows[i];
-        if (!window->Active || window->Hidden)
-            continue;
-        if (window->Flags & ImGuiWindowFlags_NoMouseInputs)
-            continue;
+    ImVec2 padding_regular, padding_for_resize_from_edges;
+    CalcWindowsHoverPadding(&padding_regular, &padding_for_resize_from_edges);
 
-        // Using the clipped AABB, a child window will typically be clipped by its parent (not always)
-        ImRect bb(window->OuterRectClipped);
-        if (window->Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize))
-            bb.Expand(padding_regular);
-        else
-            bb.Expand(padding_for_resize_from_edges);
-        if (!bb.Contains(g.IO.MousePos))
-            continue;
+    // Use the grid built by EndFrame() unless something invalidated it
+    const ImVec2* grid_padding = g.WindowsHitGridPadding;
+    const bool use_grid = g.WindowsHitGridValid && hovered_window == NULL
+        && grid_padding[0].x == padding_regular.x && grid_padding[0].y == padding_regular.y
+        && grid_padding[1].x == padding_for_resize_from_edges.x && grid_padding[1].y == padding_for_resize_from_edges.y;
+    if (use_grid)
+    {
+        const int rect_idx = g.WindowsHitGrid.FindFrontMost(g.IO.MousePos);
+        if (rect_idx != -1)
+            hovered_window = g.WindowsHitGridWindows[rect_idx];
+    }
+    else
+    {
+        for (int i = g.Windows.Size - 1; i >= 0; i--)
+        {
+            ImGuiWindow* window = g.Windows[i];
+            if (!IsWindowHoverable(window))
+                continue;
+            ImRect bb = GetWindowHoverRect(window, padding_regular, padding_for_resize_from_edges);
+            if (!bb.Contains(g.IO.MousePos))
+                continue;
 
-        // Those seemingly unnecessary extra tests are because the code here is a little different in viewport/docking branches.
-        if (hovered_window == NULL)
-            hovered_window = window;
-        if (hovered_window)
-            break;
+            // Those seemingly unnecessary extra tests are because the code here is a little different in viewport/docking branches.
+            if (hovered_window == NULL)
+                hovered_window = window;
+            if (hovered_window)
+                break;
+        }
     }
 
     g.HoveredWindow = hovered_window;
@@ -4737,6 +5888,37 @@ static ImRect GetViewportRect()
     return ImRect(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
 }
 
+// Index into g.WindowsLookupCache[] for a window ID, or for a (parent window ID, child ID) pair used by BeginChild()
+static inline int GetWindowsLookupCacheIndex(ImGuiContext& g, ImU32 key)
+{
+    key *= 0x9E3779B1;
+    key ^= key >> 16;
+    return (int)(key & (ImU32)(g.WindowsLookupCache.Size - 1));
+}
+
+// Return true if 'child_name' is the name BeginChildEx() would build for this parent window, name and id (without building it)
+static bool IsChildWindowName(const char* child_name, const char* parent_name, const char* name, ImGuiID id)
+{
+    while (*parent_name)
+        if (*child_name++ != *parent_name++)
+            return false;
+    if (*child_name++ != '/')
+        return false;
+    if (name)
+    {
+        while (*name)
+            if (*child_name++ != *name++)
+                return false;
+        if (*child_name++ != '_')
+            return false;
+    }
+    static const char hex_digits[] = "0123456789ABCDEF";
+    for (int shift = 28; shift >= 0; shift -= 4)
+        if (*child_name++ != hex_digits[(id >> shift) & 0x0F])
+            return false;
+    return *child_name == 0;
+}
+
 bool ImGui::BeginChildEx(const char* name, ImGuiID id, const ImVec2& size_arg, bool border, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
@@ -4756,11 +5938,27 @@ bool ImGui::BeginChildEx(const char* name, ImGuiID id, const ImVec2& size_arg, b
     SetNextWindowSize(size);
 
     // Build up name. If you need to append to a same child from multiple location in the ID stack, use BeginChild(ImGuiID id) with a stable value.
-    char title[256];
-    if (name)
-        ImFormatString(title, IM_ARRAYSIZE(title), "%s/%s_%08X", parent_window->Name, name, id);
-    else
-        ImFormatString(title, IM_ARRAYSIZE(title), "%s/%08X", parent_window->Name, id);
+    // When the child window was already submitted by this parent, we find it in the lookup cache and pass its stored name to Begin() instead.
+    const ImU32 lookup_key = parent_window->ID ^ (id * 0x85EBCA6B);
+    const char* title = NULL;
+    char title_buf[256];
+    if (g.WindowsLookupCache.Size > 0)
+    {
+        ImGuiWindow* cached_window = g.WindowsLookupCache[GetWindowsLookupCacheIndex(g, lookup_key)];
+        if (cached_window && cached_window->ParentWindow == parent_window && cached_window->ChildId == id && IsChildWindowName(cached_window->Name, parent_window->Name, name, id))
+        {
+            title = cached_window->Name;
+            g.WindowsLookupHint = cached_window;
+        }
+    }
+    if (title == NULL)
+    {
+        if (name)
+            ImFormatString(title_buf, IM_ARRAYSIZE(title_buf), "%s/%s_%08X", parent_window->Name, name, id);
+        else
+            ImFormatString(title_buf, IM_ARRAYSIZE(title_buf), "%s/%08X", parent_window->Name, id);
+        title = title_buf;
+    }
 
     const float backup_border_size = g.Style.ChildBorderSize;
     if (!border)
@@ -4770,6 +5968,7 @@ bool ImGui::BeginChildEx(const char* name, ImGuiID id, const ImVec2& size_arg, b
 
     ImGuiWindow* child_window = g.CurrentWindow;
     child_window->ChildId = id;
+    g.WindowsLookupCache[GetWindowsLookupCacheIndex(g, lookup_key)] = child_window;
     child_window->AutoFitChildAxises = (ImS8)auto_fit_axises;
 
     // Set the cursor to handle case where the user called SetNextWindowPos()+BeginChild() manually.
@@ -4873,7 +6072,17 @@ static void SetWindowConditionAllowFlags(ImGuiWindow* window, ImGuiCond flags, b
 ImGuiWindow* ImGui::FindWindowByID(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    return (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
+    if (g.WindowsLookupCache.Size == 0)
+        return (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
+
+    // A cache hit costs a pointer compare, compared to a binary search in g.WindowsById
+    ImGuiWindow** cache_slot = &g.WindowsLookupCache.Data[GetWindowsLookupCacheIndex(g, id)];
+    if (*cache_slot && (*cache_slot)->ID == id)
+        return *cache_slot;
+    ImGuiWindow* window = (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
+    if (window)
+        *cache_slot = window;
+    return window;
 }
 
 ImGuiWindow* ImGui::FindWindowByName(const char* name)
@@ -4900,6 +6109,16 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
     window->Flags = flags;
     g.WindowsById.SetVoidPtr(window->ID, window);
 
+    // Grow lookup cache to keep it at least twice as large as the number of windows. Entries are refilled on demand.
+    if (g.WindowsLookupCache.Size < (g.Windows.Size + 1) * 2)
+    {
+        int new_size = ImMax(g.WindowsLookupCache.Size, 64);
+        while (new_size < (g.Windows.Size + 1) * 2)
+            new_size *= 2;
+        g.WindowsLookupCache.resize(new_size);
+        memset(g.WindowsLookupCache.Data, 0, (size_t)g.WindowsLookupCache.size_in_bytes());
+    }
+
     // Default/arbitrary window position. Use SetNextWindowPos() with the appropriate condition flag to change the initial position of a window.
     window->Pos = ImVec2(60, 60);
 
@@ -5441,6 +6660,114 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// Popups opened from a window are submitted from within its contents, a cache hit would skip BeginPopup() and close them.
+static bool IsWindowParentOfPopup(const ImVector<ImGuiPopupData>& popup_stack, ImGuiWindow* window)
+{
+    for (int n = 0; n < popup_stack.Size; n++)
+    {
+        const ImGuiPopupData& popup = popup_stack[n];
+        if (popup.ParentWindow == window || popup.SourceWindow == window || (popup.Window && popup.Window->ParentWindow == window))
+            return true;
+    }
+    return false;
+}
+
+// Called by Begin() before clearing the window draw list, for windows using ImGuiWindowFlags_CacheContents (or which stopped using it).
+// See ImGuiWindowDrawListCache for details on how the buffers are exchanged.
+static void ImGui::UpdateWindowDrawListCache(ImGuiWindow* window, const ImRect& host_rect, bool title_bar_is_highlight, bool want_focus)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowDrawListCache& cache = window->DrawListCache;
+    ImDrawList* draw_list = &window->DrawListInst;
+
+    // Get back the recorded output after a frame that reused it, or record the output of the previous frame if it was cacheable.
+    // Both require the previous frame to have been rendered, otherwise the draw list may contain partial data.
+    if (cache.Swapped)
+    {
+        cache.Swap(draw_list);
+        cache.Swapped = false;
+    }
+    else if (cache.KeyThisFrame != 0 && !cache.Hit && cache.RenderedFrame == g.FrameCount - 1)
+    {
+        cache.Swap(draw_list);
+        cache.Key = cache.KeyThisFrame;
+        cache.ContentMaxOffset = window->DC.CursorMaxPos - window->DC.CursorStartPos;
+    }
+    else
+    {
+        cache.Key = 0;
+    }
+    if (cache.RenderedFrame != g.FrameCount - 1 || draw_list->_ModifiedAfterRender) // Recorded output was altered by ImDrawData::ScaleClipRects()/DeIndexAllBuffers()
+        cache.Key = 0;
+    draw_list->_ModifiedAfterRender = false;
+
+    if (!(window->Flags & ImGuiWindowFlags_CacheContents))
+    {
+        cache.ClearFreeMemory();
+        cache.KeyThisFrame = 0;
+        cache.Hit = false;
+        return;
+    }
+
+    // Output may be reused if nothing which may affect it changed. Anything interactive (hovering, active item, nav request) disables caching.
+    // DC.ChildWindows[] is from the previous frame at this point: child windows and popups are submitted from within our contents.
+    ImGuiID key = 0;
+    const bool nav_request = (g.NavWindow == window) && (g.NavMoveRequest || g.NavInitRequest || g.NavActivateId != 0 || g.NavInputId != 0 || g.NavNextActivateId != 0);
+    const bool cacheable = !want_focus && !window->Appearing && !window->Collapsed && !window->Hidden && window->HiddenFramesCannotSkipItems <= 0
+        && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->DC.ChildWindows.Size == 0
+        && g.HoveredWindow != window && g.ActiveIdWindow != window && g.ActiveIdPreviousFrameWindow != window && !nav_request
+        && !IsWindowParentOfPopup(g.OpenPopupStack, window) && !IsWindowParentOfPopup(g.BeginPopupStack, window)
+        && g.NavWindowingTarget == NULL && !(window->Flags & ImGuiWindowFlags_Modal) && !g.LogEnabled;
+    if (cacheable)
+    {
+        struct
+        {
+            ImVec2              Pos, Size, Scroll, ContentSize, DisplaySize;
+            ImRect              HostRect;
+            ImGuiWindowFlags    Flags;
+            ImGuiID             ContentHash, NavId;
+            ImFont*             Font;
+            ImTextureID         TexID;
+            float               FontSize;
+            bool                TitleBarIsHighlight, NavDisableHighlight, ScrollbarX, ScrollbarY;
+        } inputs;
+        memset(&inputs, 0, sizeof(inputs)); // Clear padding
+        inputs.Pos = window->Pos;
+        inputs.Size = window->Size;
+        inputs.Scroll = window->Scroll;
+        inputs.ContentSize = window->ContentSize;
+        inputs.DisplaySize = g.IO.DisplaySize;
+        inputs.HostRect = host_rect;
+        inputs.Flags = window->Flags;
+        inputs.ContentHash = (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasContentHash) ? g.NextWindowData.ContentHashVal : 0;
+        inputs.NavId = (g.NavWindow == window) ? g.NavId : 0;
+        inputs.Font = g.Font;
+        inputs.TexID = g.Font->ContainerAtlas->TexID;
+        inputs.FontSize = g.FontSize;
+        inputs.TitleBarIsHighlight = title_bar_is_highlight;
+        inputs.NavDisableHighlight = g.NavDisableHighlight;
+        inputs.ScrollbarX = window->ScrollbarX;
+        inputs.ScrollbarY = window->ScrollbarY;
+
+        // Style was hashed once in NewFrame(), only fold in the values currently overridden by PushStyleColor()/PushStyleVar()
+        ImGuiID style_hash = g.StyleHash;
+        for (int n = 0; n < g.ColorModifiers.Size; n++)
+            style_hash = ImHashData(&g.Style.Colors[g.ColorModifiers[n].Col], sizeof(ImVec4), ImHashData(&g.ColorModifiers[n].Col, sizeof(ImGuiCol), style_hash));
+        for (int n = 0; n < g.StyleModifiers.Size; n++)
+        {
+            const ImGuiStyleVarInfo* var_info = GetStyleVarInfo(g.StyleModifiers[n].VarIdx);
+            style_hash = ImHashData(var_info->GetVarPtr(&g.Style), var_info->Count * sizeof(float), ImHashData(&g.StyleModifiers[n].VarIdx, sizeof(ImGuiStyleVar), style_hash));
+        }
+        key = ImHashData(&inputs, sizeof(inputs), ImHashData(&style_hash, sizeof(style_hash), window->ID));
+    }
+    cache.KeyThisFrame = key;
+    cache.Hit = (key != 0 && key == cache.Key);
+    if (cache.Hit)
+        cache.HitCount++;
+    else
+        cache.MissCount++;
+}
+
 // Push a new Dear ImGui window to add widgets to.
 // - A default window called "Debug" is automatically stacked at the beginning of every frame so you can use widgets without explicitly calling a Begin/End pair.
 // - Begin/End can be called multiple times during the frame with the same window name to append content.
@@ -5451,13 +6778,15 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("Begin");
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
     IM_ASSERT(g.WithinFrameScope);                  // Forgot to call ImGui::NewFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // Called ImGui::Render() or ImGui::EndFrame() and haven't called ImGui::NewFrame() again yet
 
     // Find or create
-    ImGuiWindow* window = FindWindowByName(name);
+    ImGuiWindow* window = (g.WindowsLookupHint && g.WindowsLookupHint->Name == name) ? g.WindowsLookupHint : FindWindowByName(name);
+    g.WindowsLookupHint = NULL;
     const bool window_just_created = (window == NULL);
     if (window_just_created)
         window = CreateNewWindow(name, flags);
@@ -5859,8 +7188,18 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // DRAWING
 
+        // Retained output: decide if we can reuse the output of a previous frame (in which case the draw list will only receive decorations)
+        const ImGuiWindow* window_to_highlight = g.NavWindowingTarget ? g.NavWindowingTarget : g.NavWindow;
+        const bool title_bar_is_highlight = want_focus || (window_to_highlight && window->RootWindowForTitleBarHighlight == window_to_highlight->RootWindowForTitleBarHighlight);
+        if ((flags & ImGuiWindowFlags_CacheContents) || window->DrawListCache.Swapped || window->DrawListCache.CmdBuffer.Capacity > 0)
+            UpdateWindowDrawListCache(window, host_rect, title_bar_is_highlight, want_focus);
+
         // Setup draw list and outer clipping rectangle
         window->DrawList->Clear();
+        if (g.IO.ConfigDrawListsDeferTessellation)
+            window->DrawList->Flags |= ImDrawListFlags_DeferTessellation;
+        if (g.IO.ConfigDrawListsCpuClipRect)
+            window->DrawList->Flags |= ImDrawListFlags_CpuClipRect;
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -5896,8 +7235,6 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
                 window->DrawList = parent_window->DrawList;
 
             // Handle title bar, scrollbar, resize grips and resize borders
-            const ImGuiWindow* window_to_highlight = g.NavWindowingTarget ? g.NavWindowingTarget : g.NavWindow;
-            const bool title_bar_is_highlight = want_focus || (window_to_highlight && window->RootWindowForTitleBarHighlight == window_to_highlight->RootWindowForTitleBarHighlight);
             RenderWindowDecorations(window, title_bar_rect, title_bar_is_highlight, resize_grip_count, resize_grip_col, resize_grip_draw_size);
 
             if (render_decorations_in_parent)
@@ -5952,6 +7289,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->DC.CursorPos = window->DC.CursorStartPos;
         window->DC.CursorPosPrevLine = window->DC.CursorPos;
         window->DC.CursorMaxPos = window->DC.CursorStartPos;
+        if (window->DrawListCache.Hit)
+            window->DC.CursorMaxPos += window->DrawListCache.ContentMaxOffset; // Contents won't be submitted, preserve ContentSize
         window->DC.CurrLineSize = window->DC.PrevLineSize = ImVec2(0.0f, 0.0f);
         window->DC.CurrLineTextBaseOffset = window->DC.PrevLineTextBaseOffset = 0.0f;
 
@@ -6064,6 +7403,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     if (window->Collapsed || !window->Active || window->Hidden)
         if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->HiddenFramesCannotSkipItems <= 0)
             skip_items = true;
+    if (window->DrawListCache.Hit)
+        skip_items = true;
     window->SkipItems = skip_items;
 
     return !skip_items;
@@ -6073,6 +7414,7 @@ void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
+    IMGUI_PROFILER_ZONE("End");
 
     // Error checking: verify that user hasn't called End() too many times!
     if (g.CurrentWindowStack.Size <= 1 && g.WithinFrameScopeWithImplicitWindow)
@@ -6123,6 +7465,7 @@ void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
     ImGuiWindow* current_front_window = g.Windows.back();
     if (current_front_window == window || current_front_window->RootWindow == window)
         return;
+    g.WindowsHitGridValid = false;
     for (int i = g.Windows.Size - 2; i >= 0; i--) // We can ignore the top-most window
         if (g.Windows[i] == window)
         {
@@ -6137,6 +7480,7 @@ void ImGui::BringWindowToDisplayBack(ImGuiWindow* window)
     ImGuiContext& g = *GImGui;
     if (g.Windows[0] == window)
         return;
+    g.WindowsHitGridValid = false;
     for (int i = 0; i < g.Windows.Size; i++)
         if (g.Windows[i] == window)
         {
@@ -6531,6 +7875,13 @@ void ImGui::SetWindowFocus(const char* name)
     }
 }
 
+void ImGui::InvalidateWindowCache(const char* name)
+{
+    // Also discard the output of the current frame, which may be recorded on next Begin()
+    if (ImGuiWindow* window = FindWindowByName(name))
+        window->DrawListCache.Key = window->DrawListCache.KeyThisFrame = 0;
+}
+
 void ImGui::SetNextWindowPos(const ImVec2& pos, ImGuiCond cond, const ImVec2& pivot)
 {
     ImGuiContext& g = *GImGui;
@@ -6597,6 +7948,13 @@ void ImGui::SetNextWindowBgAlpha(float alpha)
     g.NextWindowData.BgAlphaVal = alpha;
 }
 
+void ImGui::SetNextWindowContentHash(ImGuiID hash)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasContentHash;
+    g.NextWindowData.ContentHashVal = hash;
+}
+
 ImDrawList* ImGui::GetWindowDrawList()
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -6956,6 +8314,7 @@ bool ImGui::ItemAdd(const ImRect& bb, ImGuiID id, const ImRect* nav_bb_arg)
 {
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
+    IMGUI_PROFILER_ZONE("ItemAdd");
 
     if (id != 0)
     {
@@ -7626,6 +8985,7 @@ void ImGui::OpenPopupEx(ImGuiID id)
     popup_ref.PopupId = id;
     popup_ref.Window = NULL;
     popup_ref.SourceWindow = g.NavWindow;
+    popup_ref.ParentWindow = parent_window;
     popup_ref.OpenFrameCount = g.FrameCount;
     popup_ref.OpenParentId = parent_window->IDStack.back();
     popup_ref.OpenPopupPos = NavCalcPreferredRefPos();
@@ -8438,6 +9798,7 @@ ImVec2 ImGui::GetNavInputAmount2d(ImGuiNavDirSourceFlags dir_sources, ImGuiInput
 static void ImGui::NavUpdate()
 {
     ImGuiContext& g = *GImGui;
+    IMGUI_PROFILER_ZONE("NavUpdate");
     g.IO.WantSetMousePos = false;
     g.NavWrapRequestWindow = NULL;
     g.NavWrapRequestFlags = ImGuiNavMoveFlags_None;
@@ -9953,6 +11314,29 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
     }
 }
 
+// .ini data without a [Hash] entry was written with the default CRC32 function
+static void HashSettingsHandler_ReadInit(ImGuiContext* ctx, ImGuiSettingsHandler*)
+{
+    ImGuiContext& g = *ctx;
+    g.SettingsHashMismatch = (strcmp(ImHashGetFunctionName(), "CRC32") != 0);
+}
+
+static void* HashSettingsHandler_ReadOpen(ImGuiContext* ctx, ImGuiSettingsHandler*, const char* name)
+{
+    ImGuiContext& g = *ctx;
+    g.SettingsHashMismatch = (strcmp(ImHashGetFunctionName(), name) != 0);
+    return NULL;
+}
+
+// Only write "[Hash][Name]" when not using the default function, so default .ini files are unchanged.
+static void HashSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    const char* name = ImHashGetFunctionName();
+    if (strcmp(name, "CRC32") == 0)
+        return;
+    buf->appendf("[%s][%s]\n\n", handler->TypeName, name);
+}
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] VIEWPORTS, PLATFORM WINDOWS
@@ -9968,6 +11352,57 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
 // (this section is filled in the 'docking' branch)
 
 
+//-----------------------------------------------------------------------------
+// [SECTION] PROFILER
+//-----------------------------------------------------------------------------
+// - ImGuiProfilerZoneScope (when IMGUI_ENABLE_PROFILER is defined)
+// - ProfilerZoneEnd() [Internal]
+// - SetProfilerZoneCallback() [Internal]
+//-----------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_PROFILER
+ImGuiProfilerZoneScope::ImGuiProfilerZoneScope(const char* name)
+{
+    ImGuiContext& g = *GImGui;
+    Name = name;
+    TicksBegin = ImGui::ProfilerGetTicks();
+    g.ProfilerDepth++;
+}
+
+ImGuiProfilerZoneScope::~ImGuiProfilerZoneScope()
+{
+    ImGui::ProfilerZoneEnd(Name, TicksBegin);
+}
+#endif
+
+void ImGui::ProfilerZoneEnd(const char* name, ImU64 ticks_begin)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.ProfilerDepth > 0);
+    g.ProfilerDepth--;
+    if (g.ProfilerZones.Size == 0)
+        g.ProfilerZones.resize(IMGUI_PROFILER_ZONES_CAPACITY);
+
+    ImGuiProfilerZone* zone = &g.ProfilerZones[g.ProfilerZonesHead];
+    zone->Name = name;
+    zone->TicksBegin = ticks_begin;
+    zone->TicksEnd = ProfilerGetTicks();
+    zone->Depth = g.ProfilerDepth;
+    zone->FrameCount = g.FrameCount;
+    g.ProfilerZonesHead = (g.ProfilerZonesHead + 1) % g.ProfilerZones.Size;
+    g.ProfilerZonesCount = ImMin(g.ProfilerZonesCount + 1, g.ProfilerZones.Size);
+    if (g.ProfilerZoneCallback)
+        g.ProfilerZoneCallback(zone, g.ProfilerZoneCallbackUserData);
+}
+
+void ImGui::SetProfilerZoneCallback(ImGuiProfilerZoneCallback callback, void* user_data)
+{
+    ImGuiContext& g = *GImGui;
+    g.ProfilerZoneCallback = callback;
+    g.ProfilerZoneCallbackUserData = user_data;
+}
+
+
 //-----------------------------------------------------------------------------
 // [SECTION] PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
@@ -10128,6 +11563,21 @@ static void ImeSetInputScreenPosFn_DefaultImpl(int, int) {}
 
 #endif
 
+// High resolution timer used by the profiler
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+ImU64 ImGui::ProfilerGetTicks()             { LARGE_INTEGER counter; ::QueryPerformanceCounter(&counter); return (ImU64)counter.QuadPart; }
+ImU64 ImGui::ProfilerGetTicksPerSecond()    { LARGE_INTEGER freq; ::QueryPerformanceFrequency(&freq); return (ImU64)freq.QuadPart; }
+#elif defined(IMGUI_ENABLE_PROFILER) && defined(CLOCK_MONOTONIC)
+ImU64 ImGui::ProfilerGetTicks()             { struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts); return (ImU64)ts.tv_sec * 1000000000 + (ImU64)ts.tv_nsec; }
+ImU64 ImGui::ProfilerGetTicksPerSecond()    { return 1000000000; }
+#elif defined(IMGUI_ENABLE_PROFILER)
+ImU64 ImGui::ProfilerGetTicks()             { return (ImU64)clock(); }
+ImU64 ImGui::ProfilerGetTicksPerSecond()    { return (ImU64)CLOCKS_PER_SEC; }
+#else
+ImU64 ImGui::ProfilerGetTicks()             { return 0; }
+ImU64 ImGui::ProfilerGetTicksPerSecond()    { return 1; }
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] METRICS/DEBUG WINDOW
 //-----------------------------------------------------------------------------
@@ -10176,8 +11626,38 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     ImGui::Text("Dear ImGui %s", ImGui::GetVersion());
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     ImGui::Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    if (io.ConfigDrawDataMergeCommands && (io.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena))
+        ImGui::Text("%d draw calls (%d merged across draw lists)", io.MetricsRenderDrawCalls, g.DrawDataBuilder.ArenaCmdMergedCount);
+    else
+        ImGui::Text("%d draw calls", io.MetricsRenderDrawCalls);
     ImGui::Text("%d active windows (%d visible)", io.MetricsActiveWindows, io.MetricsRenderWindows);
-    ImGui::Text("%d active allocations", io.MetricsActiveAllocations);
+    ImGui::Text("%d active allocations, %d allocations last frame", io.MetricsActiveAllocations, io.MetricsFrameAllocations);
+    ImGui::Text("Frame arena: %d bytes used last frame, %d bytes capacity", io.MetricsFrameArenaBytes, (int)g.FrameArena.GetCapacity());
+    {
+        int cache_windows = 0, cache_windows_hit = 0, cache_hits = 0, cache_misses = 0;
+        for (int n = 0; n < g.Windows.Size; n++)
+            if ((g.Windows[n]->Flags & ImGuiWindowFlags_CacheContents) && g.Windows[n]->Active)
+            {
+                const ImGuiWindowDrawListCache& cache = g.Windows[n]->DrawListCache;
+                cache_windows++;
+                cache_windows_hit += cache.Hit ? 1 : 0;
+                cache_hits += cache.HitCount;
+                cache_misses += cache.MissCount;
+            }
+        if (cache_windows > 0)
+            ImGui::Text("%d/%d cached windows reused (%d hits, %d misses, %.1f%% hit rate)", cache_windows_hit, cache_windows, cache_hits, cache_misses, cache_hits * 100.0f / ImMax(cache_hits + cache_misses, 1));
+    }
+    if (g.DrawListSharedData.TextCache)
+    {
+        const ImFontTextCache& cache = g.TextCache;
+        ImGui::Text("Text cache: %d entries, %d/%d KB (%d hits, %d misses, %.1f%% hit rate, %d evicted)", cache.Entries.Size, cache.GetMemoryUsage() / 1024, io.ConfigTextCacheBudget / 1024,
+            cache.HitCount, cache.MissCount, cache.HitCount * 100.0f / ImMax(cache.HitCount + cache.MissCount, 1), cache.EvictCount);
+    }
+    if (io.ConfigMemoryCompactBudget > 0)
+        ImGui::Text("Memory budget: %d/%d KB used by windows buffers, %d KB reclaimed (%d windows compacted, %d shrunk)", (int)(g.GcMemoryUsage / 1024), io.ConfigMemoryCompactBudget / 1024,
+            (int)(g.GcReclaimedBytes / 1024), g.GcCompactedWindowsCount, g.GcShrunkWindowsCount);
+    else if (g.GcReclaimedBytes > 0)
+        ImGui::Text("Memory compaction: %d KB reclaimed from unused windows", (int)(g.GcReclaimedBytes / 1024));
     ImGui::Separator();
 
     // Helper functions to display common structures:
@@ -10244,6 +11724,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 if (node_open) ImGui::TreePop();
                 return;
             }
+            draw_list->_FlushDeferred();
 
             ImDrawList* fg_draw_list = GetForegroundDrawList(window); // Render additional visuals into the top-most draw list
             if (window && IsItemHovered())
@@ -10253,6 +11734,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
             if (window && !window->WasActive)
                 ImGui::TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
+            ImGui::BulletText("Capacity: %d vtx, %d indices (%d KB)", draw_list->VtxBuffer.Capacity, draw_list->IdxBuffer.Capacity,
+                (int)(((size_t)draw_list->VtxBuffer.Capacity * sizeof(ImDrawVert) + (size_t)draw_list->IdxBuffer.Capacity * sizeof(ImDrawIdx)) / 1024));
 
             unsigned int elem_offset = 0;
             for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); elem_offset += pcmd->ElemCount, pcmd++)
@@ -10303,9 +11786,10 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                         for (int n = 0; n < 3; n++, idx_i++)
                         {
                             ImDrawVert& v = draw_list->VtxBuffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
-                            triangle[n] = v.pos;
+                            const ImVec2 pos = v.pos, uv = v.uv;
+                            triangle[n] = pos;
                             buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                                (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                                (n == 0) ? "Vert:" : "     ", idx_i, pos.x, pos.y, uv.x, uv.y, v.col);
                         }
 
                         ImGui::Selectable(buf, false);
@@ -10362,6 +11846,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 ImGui::TextDisabled("Note: window is not currently visible.");
             if (window->MemoryCompacted)
                 ImGui::TextDisabled("Note: some memory buffers have been compacted/freed.");
+            else
+                ImGui::BulletText("Transient buffers: %d KB", (int)(ImGui::GcCalcTransientWindowBuffersSize(window) / 1024));
 
             ImGuiWindowFlags flags = window->Flags;
             NodeDrawList(window, window->DrawList, "DrawList");
@@ -10373,6 +11859,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             ImGui::BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
             ImGui::BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
             ImGui::BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+            if (flags & ImGuiWindowFlags_CacheContents)
+                ImGui::BulletText("DrawListCache: Hit: %d, HitCount: %d, MissCount: %d, Key: 0x%08X", window->DrawListCache.Hit, window->DrawListCache.HitCount, window->DrawListCache.MissCount, window->DrawListCache.Key);
             ImGui::BulletText("NavLastIds: 0x%08X,0x%08X, NavLayerActiveMask: %X", window->NavLastIds[0], window->NavLastIds[1], window->DC.NavLayerActiveMask);
             ImGui::BulletText("NavLastChildNavWindow: %s", window->NavLastChildNavWindow ? window->NavLastChildNavWindow->Name : "NULL");
             if (!window->NavRectRel[0].IsInverted())
@@ -10422,11 +11910,22 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
         static void NodeStorage(ImGuiStorage* storage, const char* label)
         {
+#ifndef IMGUI_USE_HASHED_STORAGE
             if (!ImGui::TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
                 return;
+#else
+            if (!ImGui::TreeNode(label, "%s: %d entries, %d slots, %d bytes", label, storage->DataCount + (storage->ZeroKeyUsed ? 1 : 0), storage->Data.Size, storage->Data.size_in_bytes()))
+                return;
+            if (storage->ZeroKeyUsed)
+                ImGui::BulletText("Key 0x%08X Value { i: %d }", 0, storage->ZeroKeyPair.val_i);
+#endif
             for (int n = 0; n < storage->Data.Size; n++)
             {
                 const ImGuiStorage::ImGuiStoragePair& p = storage->Data[n];
+#ifdef IMGUI_USE_HASHED_STORAGE
+                if (p.key == 0)
+                    continue;
+#endif
                 ImGui::BulletText("Key 0x%08X Value { i: %d }", p.key, p.val_i); // Important: we currently don't store a type, real value may not be integer.
             }
             ImGui::TreePop();
@@ -10527,6 +12026,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         else
             ImGui::TextUnformatted("<NULL>");
         ImGui::Text("SettingsDirtyTimer %.2f", g.SettingsDirtyTimer);
+        ImGui::Text("Hash function: %s%s", ImHashGetFunctionName(), g.SettingsHashMismatch ? " (last loaded .ini used a different function!)" : "");
         if (ImGui::TreeNode("SettingsHandlers", "Settings handlers: (%d)", g.SettingsHandlers.Size))
         {
             for (int n = 0; n < g.SettingsHandlers.Size; n++)
@@ -10561,6 +12061,98 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::TreePop();
     }
 
+    // Profiler
+    if (ImGui::TreeNode("Profiler"))
+    {
+#ifdef IMGUI_ENABLE_PROFILER
+        struct ZoneStats { const char* Name; int Count; ImU64 TicksTotal; ImU64 TicksMax; };
+        ImVector<ZoneStats> stats;
+        const int frame_count = g.FrameCount - 1; // Last complete frame
+        const double ms_per_tick = 1000.0 / (double)ImGui::ProfilerGetTicksPerSecond();
+        for (int n = 0; n < g.ProfilerZonesCount; n++)
+        {
+            const ImGuiProfilerZone* zone = &g.ProfilerZones[(g.ProfilerZonesHead - 1 - n + g.ProfilerZones.Size) % g.ProfilerZones.Size];
+            if (zone->FrameCount != frame_count)
+                continue;
+            ZoneStats* zone_stats = NULL;
+            for (int stats_n = 0; stats_n < stats.Size && zone_stats == NULL; stats_n++)
+                if (stats[stats_n].Name == zone->Name)
+                    zone_stats = &stats[stats_n];
+            if (zone_stats == NULL)
+            {
+                ZoneStats new_stats = { zone->Name, 0, 0, 0 };
+                stats.push_back(new_stats);
+                zone_stats = &stats.back();
+            }
+            const ImU64 ticks = zone->TicksEnd - zone->TicksBegin;
+            zone_stats->Count++;
+            zone_stats->TicksTotal += ticks;
+            zone_stats->TicksMax = ImMax(zone_stats->TicksMax, ticks);
+        }
+        ImGui::Text("Ring buffer: %d/%d zones", g.ProfilerZonesCount, IMGUI_PROFILER_ZONES_CAPACITY);
+        ImGui::SameLine();
+        MetricsHelpMarker("Zones are aggregated over the last complete frame.\nIf the ring buffer is too small to hold a full frame, increase IMGUI_PROFILER_ZONES_CAPACITY.");
+        for (int n = 0; n < stats.Size; n++)
+            ImGui::BulletText("%-36s %5d calls, total %.3f ms, max %.3f ms", stats[n].Name, stats[n].Count, stats[n].TicksTotal * ms_per_tick, stats[n].TicksMax * ms_per_tick);
+        if (ImGui::TreeNode("Recent zones"))
+        {
+            ImGuiListClipper clipper(g.ProfilerZonesCount);
+            while (clipper.Step())
+                for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                {
+                    const ImGuiProfilerZone* zone = &g.ProfilerZones[(g.ProfilerZonesHead - 1 - n + g.ProfilerZones.Size) % g.ProfilerZones.Size];
+                    ImGui::Text("[%05d] %*s%s: %.4f ms", zone->FrameCount, zone->Depth * 2, "", zone->Name, (zone->TicksEnd - zone->TicksBegin) * ms_per_tick);
+                }
+            ImGui::TreePop();
+        }
+#else
+        ImGui::TextDisabled("Define IMGUI_ENABLE_PROFILER in imconfig.h to record profiler zones.");
+#endif
+        ImGui::TreePop();
+    }
+
+    // Allocations
+    if (ImGui::TreeNode("Allocations"))
+    {
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+        struct SiteComparer
+        {
+            static int IMGUI_CDECL ByCount(const void* lhs, const void* rhs)            { return (*(const ImGuiAllocSite* const*)rhs)->Count - (*(const ImGuiAllocSite* const*)lhs)->Count; }
+            static int IMGUI_CDECL ByCountLastFrame(const void* lhs, const void* rhs)   { return (*(const ImGuiAllocSite* const*)rhs)->CountLastFrame - (*(const ImGuiAllocSite* const*)lhs)->CountLastFrame; }
+        };
+        static bool sort_by_last_frame = false;
+        ImGui::Text("%d/%d call sites, %d allocations last frame", g.AllocSitesCount, IMGUI_ALLOC_SITES_CAPACITY, io.MetricsFrameAllocations);
+        ImGui::SameLine();
+        MetricsHelpMarker("Allocations are attributed to the innermost IMGUI_ALLOC_SCOPE() (e.g. ImDrawList, ImPool), otherwise to the file/line of their IM_ALLOC()/IM_NEW() call.\nImVector<> growth outside of a scope is attributed to ImVector::reserve() in imgui.h.");
+        ImGui::Checkbox("Sort by allocations during last frame", &sort_by_last_frame);
+        const ImGuiAllocSite** sites = g.FrameArena.AllocArray<const ImGuiAllocSite*>(g.AllocSitesCount);
+        for (int n = 0; n < g.AllocSitesCount; n++)
+            sites[n] = &g.AllocSites[n];
+        ImQsort(sites, (size_t)g.AllocSitesCount, sizeof(*sites), sort_by_last_frame ? SiteComparer::ByCountLastFrame : SiteComparer::ByCount);
+        for (int n = 0; n < g.AllocSitesCount; n++)
+        {
+            const ImGuiAllocSite* site = sites[n];
+            char label[64];
+            if (site->Line > 0)
+            {
+                const char* filename = site->Name;
+                for (const char* p = site->Name; *p; p++)
+                    if (*p == '/' || *p == '\\')
+                        filename = p + 1;
+                ImFormatString(label, IM_ARRAYSIZE(label), "%s(%d)", filename, site->Line);
+            }
+            else
+            {
+                ImStrncpy(label, site->Name, IM_ARRAYSIZE(label));
+            }
+            ImGui::BulletText("%-28s %7d allocs, %9.1f KB, %5d last frame", label, site->Count, (double)site->Bytes / 1024.0, site->CountLastFrame);
+        }
+#else
+        ImGui::TextDisabled("Define IMGUI_ENABLE_ALLOC_TRACKING in imconfig.h to record allocations per call site.");
+#endif
+        ImGui::TreePop();
+    }
+
     // Misc Details
     if (ImGui::TreeNode("Internal state"))
     {
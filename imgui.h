@@ -29,7 +29,7 @@ Index of this file:
 // ImGuiIO
 // Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // Obsolete functions
-// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiTextIndex, ImGuiStorage, ImGuiListClipper, ImColor)
 // Draw List API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
 // Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 
@@ -115,6 +115,7 @@ struct ImDrawChannel;               // Temporary storage to output draw commands
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
+struct ImDrawListDeferred;          // Primitives recorded by a draw list using ImDrawListFlags_DeferTessellation, waiting for their vertices to be generated
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
@@ -135,6 +136,7 @@ struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTextIndex;              // Helper to hold line offsets of an append-only text buffer, for TextUnformattedIndexed()
 
 // Enums/Flags (declared as int for compatibility with old C++, to allow using as flags and to not pollute the top of this file)
 // - Tip: Use your programming IDE navigation facilities on the names in the _central column_ below to find the actual flags/enum lists!
@@ -309,6 +311,7 @@ namespace ImGui
     IMGUI_API void          SetNextWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                 // set next window collapsed state. call before Begin()
     IMGUI_API void          SetNextWindowFocus();                                                       // set next window to be focused / top-most. call before Begin()
     IMGUI_API void          SetNextWindowBgAlpha(float alpha);                                          // set next window background color alpha. helper to easily override the Alpha component of ImGuiCol_WindowBg/ChildBg/PopupBg. you may also use ImGuiWindowFlags_NoBackground.
+    IMGUI_API void          SetNextWindowContentHash(ImGuiID hash);                                     // set hash of the data displayed by next window, for ImGuiWindowFlags_CacheContents: the cached output is discarded when it changes. call before Begin()
     IMGUI_API void          SetWindowPos(const ImVec2& pos, ImGuiCond cond = 0);                        // (not recommended) set current window position - call within Begin()/End(). prefer using SetNextWindowPos(), as this may incur tearing and side-effects.
     IMGUI_API void          SetWindowSize(const ImVec2& size, ImGuiCond cond = 0);                      // (not recommended) set current window size - call within Begin()/End(). set to ImVec2(0,0) to force an auto-fit. prefer using SetNextWindowSize(), as this may incur tearing and minor side-effects.
     IMGUI_API void          SetWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                     // (not recommended) set current window collapsed state. prefer using SetNextWindowCollapsed().
@@ -318,6 +321,7 @@ namespace ImGui
     IMGUI_API void          SetWindowSize(const char* name, const ImVec2& size, ImGuiCond cond = 0);    // set named window size. set axis to 0.0f to force an auto-fit on this axis.
     IMGUI_API void          SetWindowCollapsed(const char* name, bool collapsed, ImGuiCond cond = 0);   // set named window collapsed state
     IMGUI_API void          SetWindowFocus(const char* name);                                           // set named window to be focused / top-most. use NULL to remove focus.
+    IMGUI_API void          InvalidateWindowCache(const char* name);                                    // discard cached output of named window using ImGuiWindowFlags_CacheContents, so its contents are submitted again on next Begin().
 
     // Content region
     // - Those functions are bound to be redesigned soon (they are confusing, incomplete and return values in local window coordinates which increases confusion)
@@ -417,6 +421,7 @@ namespace ImGui
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
+    IMGUI_API void          TextUnformattedIndexed(const char* text, const char* text_end, ImGuiTextIndex* index); // raw text using a persistent line index: only the appended text and the visible lines are processed, for very large append-only buffers (e.g. logs). No word-wrapping.
     IMGUI_API void          Text(const char* fmt, ...)                                      IM_FMTARGS(1); // formatted text
     IMGUI_API void          TextV(const char* fmt, va_list args)                            IM_FMTLIST(1);
     IMGUI_API void          TextColored(const ImVec4& col, const char* fmt, ...)            IM_FMTARGS(2); // shortcut for PushStyleColor(ImGuiCol_Text, col); Text(fmt, ...); PopStyleColor();
@@ -561,6 +566,7 @@ namespace ImGui
     IMGUI_API void          PlotLines(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
     IMGUI_API void          PlotHistogram(const char* label, const float* values, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0), int stride = sizeof(float));
     IMGUI_API void          PlotHistogram(const char* label, float(*values_getter)(void* data, int idx), void* data, int values_count, int values_offset = 0, const char* overlay_text = NULL, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = ImVec2(0, 0));
+    IMGUI_API void          SetNextPlotDataVersion(int data_version);                           // decimate next PlotLines()/PlotHistogram() call to the min/max envelope of the samples of each pixel column. min/max are read from a cache which is only rebuilt when the data pointer, count or 'data_version' changes: increment it whenever you modify your values.
 
     // Widgets: Value() Helpers.
     // - Those are merely shortcut to calling Text() with a format string. Output single value in "name: value" format (tip: freely declare more in your code to handle your types. you can add functions to the ImGui namespace)
@@ -758,6 +764,7 @@ namespace ImGui
     // - If you reload the contents of imgui.cpp at runtime, you may need to call SetCurrentContext() + SetAllocatorFunctions() again because we use global storage for those.
     IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = NULL);
     IMGUI_API void*         MemAlloc(size_t size);
+    IMGUI_API void*         MemAllocEx(size_t size, const char* file, int line);    // Same as MemAlloc(), recording the call site when IMGUI_ENABLE_ALLOC_TRACKING is defined (used by IM_ALLOC()/IM_NEW() in that case).
     IMGUI_API void          MemFree(void* ptr);
 
 } // namespace ImGui
@@ -790,6 +797,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavInputs            = 1 << 18,  // No gamepad/keyboard navigation within the window
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Append '*' to title without affecting the ID, as a convenience to avoid using the ### operator. When used in a tab/docking context, tab is selected on closure and closure is deferred by one frame to allow code to cancel the closure (with a confirmation popup, etc.) without flicker.
+    ImGuiWindowFlags_CacheContents          = 1 << 21,  // [BETA] Reuse last frame output of the window when none of its inputs changed (not hovered, no active item or nav request, same position/size/scroll/focus/style and SetNextWindowContentHash() value). Begin() then returns false: only submit contents when Begin() returns true! Windows with child windows or popups are never cached. The cached buffers are rendered from the window ImDrawList: treat ImDrawData as read-only (ImDrawData::ScaleClipRects()/DeIndexAllBuffers() discard the cache).
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
     ImGuiWindowFlags_NoInputs               = ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
@@ -1081,7 +1089,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasGamepad            = 1 << 0,   // Back-end Platform supports gamepad and currently has one connected.
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Back-end Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Back-end Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
-    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3    // Back-end Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Back-end Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasDrawDataArena = 1 << 4 // Back-end Renderer reads ImDrawData::ArenaVtxBuffer/ArenaIdxBuffer/ArenaCmdBuffer (whole frame in a single vertex and index buffer). Requires ImGuiBackendFlags_RendererHasVtxOffset.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -1284,10 +1293,15 @@ enum ImGuiCond_
 struct ImNewDummy {};
 inline void* operator new(size_t, ImNewDummy, void* ptr) { return ptr; }
 inline void  operator delete(void*, ImNewDummy, void*)   {} // This is only required so we can use the symmetrical new()
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+#define IM_ALLOC(_SIZE)                     ImGui::MemAllocEx(_SIZE, __FILE__, __LINE__)
+#define IM_NEW(_TYPE)                       new(ImNewDummy(), ImGui::MemAllocEx(sizeof(_TYPE), __FILE__, __LINE__)) _TYPE
+#else
 #define IM_ALLOC(_SIZE)                     ImGui::MemAlloc(_SIZE)
+#define IM_NEW(_TYPE)                       new(ImNewDummy(), ImGui::MemAlloc(sizeof(_TYPE))) _TYPE
+#endif
 #define IM_FREE(_PTR)                       ImGui::MemFree(_PTR)
 #define IM_PLACEMENT_NEW(_PTR)              new(ImNewDummy(), _PTR)
-#define IM_NEW(_TYPE)                       new(ImNewDummy(), ImGui::MemAlloc(sizeof(_TYPE))) _TYPE
 template<typename T> void IM_DELETE(T* p)   { if (p) { p->~T(); ImGui::MemFree(p); } }
 
 //-----------------------------------------------------------------------------
@@ -1450,6 +1464,13 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // [BETA] Set to true to only allow moving windows when clicked+dragged from the title bar. Windows without a title bar are not affected.
     float       ConfigWindowsMemoryCompactTimer;// = 60.0f          // [BETA] Compact window memory usage when unused. Set to -1.0f to disable.
+    int         ConfigMemoryCompactBudget;      // = 0              // [BETA] Memory budget (in bytes) of windows transient buffers (draw lists, ID stacks, cached contents) and input text state. Checked by NewFrame(): when exceeded, buffers of the least recently active windows are freed first, then over-grown draw list buffers of active windows are shrunk. e.g. 4*1024*1024. Set to 0 to disable.
+    bool        ConfigDrawListsDeferTessellation; // = false        // [BETA] Record lines, convex fills and text submitted to window draw lists, and generate their vertices in Render(). Each window draw list is processed with io.ParallelForFn when set.
+    int         ConfigDrawListsShrinkFrames;    // = 0              // [BETA] Shrink vertex/index buffers of draw lists whose peak usage stayed below 1/4 of their capacity for this number of frames (e.g. 300), instead of keeping their largest capacity forever. Set to 0 to disable.
+    bool        ConfigDrawListsPreSize;         // = false          // [BETA] When a draw list is cleared for a new frame, grow its vertex/index buffers if the previous frame filled more than 3/4 of them: growing empty buffers doesn't copy anything, unlike growing them while primitives are being added.
+    bool        ConfigDrawListsCpuClipRect;     // = false          // [BETA] Set ImDrawListFlags_CpuClipRect on window draw lists: text, images and rectangles in nested clip rectangles (e.g. columns) are clipped on the CPU and share the draw command of the enclosing clip rectangle.
+    bool        ConfigDrawDataMergeCommands;    // = false          // [BETA] When the renderer back-end uses the draw data arena (ImGuiBackendFlags_RendererHasDrawDataArena), merge consecutive draw commands of different draw lists using the same texture, when their clip rectangles are equal or don't clip anything. Merged commands are left with ElemCount == 0 in ImDrawData::ArenaCmdBuffer.
+    int         ConfigTextCacheBudget;          // = 0              // [BETA] Memory budget (in bytes) of a cache of text layouts, so text which doesn't change skips UTF-8 decoding and glyph lookups in CalcTextSize() and rendering. e.g. 256*1024. Mostly useful for non-ASCII text, and with IMGUI_USE_WORD_HASH or IMGUI_USE_CRC32C_HASH. Set to 0 to disable.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -1474,6 +1495,19 @@ struct ImGuiIO
     void        (*ImeSetInputScreenPosFn)(int x, int y);
     void*       ImeWindowHandle;                // = NULL           // (Windows) Set this to your HWND to get automatic IME cursor positioning.
 
+    // Optional: Run independent jobs on your own job system/thread pool (used by io.ConfigDrawListsDeferTessellation)
+    // Your function must call 'job(job_data, i)' for every 'i' in [0, count), on any thread, and only return once all calls have completed.
+    // (default to NULL, running jobs serially on the calling thread)
+    void        (*ParallelForFn)(void* user_data, int count, void (*job)(void* job_data, int index), void* job_data);
+    void*       ParallelForUserData;
+
+    // Optional: Provide the memory of the draw data arena (used with ImGuiBackendFlags_RendererHasDrawDataArena), e.g. persistently mapped GPU buffers.
+    // Render() calls this with the number of vertices/indices of the frame, the memory needs to stay valid until you are done rendering the ImDrawData.
+    // Render() only writes to it (it may be write-only mapped memory), including when merging commands with io.ConfigDrawDataMergeCommands.
+    // Return false to use memory owned by the context instead. (default to NULL)
+    bool        (*DrawDataArenaAllocFn)(void* user_data, int vtx_count, int idx_count, void** out_vtx_buffer, void** out_idx_buffer); // Output ImDrawVert*/ImDrawIdx* buffers
+    void*       DrawDataArenaUserData;
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     // [OBSOLETE since 1.60+] Rendering function, will be automatically called in Render(). Please call your rendering function yourself now!
     // You can obtain the ImDrawData* by calling ImGui::GetDrawData() after Render(). See example applications if you are unsure of how to implement this.
@@ -1520,9 +1554,12 @@ struct ImGuiIO
     float       Framerate;                      // Application framerate estimate, in frame per second. Solely for convenience. Rolling average estimation based on io.DeltaTime over 120 frames.
     int         MetricsRenderVertices;          // Vertices output during last call to Render()
     int         MetricsRenderIndices;           // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderDrawCalls;         // Draw commands output during last call to Render(), not counting the ones merged by io.ConfigDrawDataMergeCommands
     int         MetricsRenderWindows;           // Number of visible windows
     int         MetricsActiveWindows;           // Number of active windows
     int         MetricsActiveAllocations;       // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsFrameAllocations;        // Number of allocations (MemAlloc calls) made during the last frame, from NewFrame() to NewFrame(). Zero in steady state once buffers have grown.
+    int         MetricsFrameArenaBytes;         // Bytes of temporary memory used during the last frame, served by the frame arena instead of MemAlloc
     ImVec2      MouseDelta;                     // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     //------------------------------------------------------------------
@@ -1725,6 +1762,27 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Line offsets of an append-only text buffer, used by TextUnformattedIndexed()
+// The index doesn't own the text: keep one instance per buffer and call clear() when the buffer is cleared or
+// modified other than by appending. TextUnformattedIndexed() indexes newly appended text on its own, and
+// automatically clears the index if the buffer got smaller. Lines widths are measured once, as they are indexed.
+struct ImGuiTextIndex
+{
+    ImVector<int>       LineOffsets;            // Offset of the beginning of each line
+    int                 EndOffset;              // Size of the text indexed so far
+    int                 WidthLinesCount;        // Number of lines (all complete) accounted for in WidthMax
+    float               WidthMax;               // Maximum width of the first WidthLinesCount lines
+    ImFont*             WidthFont;              // Font and size used to measure lines, WidthMax is reset when they change
+    float               WidthFontSize;
+
+    ImGuiTextIndex()    { clear(); }
+    void                clear()                                 { LineOffsets.clear(); EndOffset = WidthLinesCount = 0; WidthMax = 0.0f; WidthFont = NULL; WidthFontSize = 0.0f; }
+    int                 size() const                            { return LineOffsets.Size; }
+    const char*         get_line_begin(const char* base, int n) const { return base + LineOffsets[n]; }
+    const char*         get_line_end(const char* base, int n) const   { return base + (n + 1 < LineOffsets.Size ? (LineOffsets[n + 1] - 1) : EndOffset); }
+    IMGUI_API void      append(const char* base, int old_size, int new_size);
+};
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
@@ -1745,12 +1803,24 @@ struct ImGuiStorage
         ImGuiStoragePair(ImGuiID _key, void* _val_p)    { key = _key; val_p = _val_p; }
     };
 
+#ifndef IMGUI_USE_HASHED_STORAGE
     ImVector<ImGuiStoragePair>      Data;
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
     void                Clear() { Data.clear(); }
+#else
+    ImVector<ImGuiStoragePair>      Data;           // Open-addressing hash table: Size is zero or a power of two, unused slots have a zero key
+    int                             DataCount;      // Number of used slots in Data[]
+    bool                            ZeroKeyUsed;    // As a zero key marks unused slots, the value for key 0 is stored separately in ZeroKeyPair
+    ImGuiStoragePair                ZeroKeyPair;
+
+    // - Get***() functions find pair, never add/allocate. Queries are O(1) on average (linear probing).
+    // - Set***() functions find pair, insertion on demand if missing. Insertion is O(1) amortized (the table is rebuilt when 3/4 full).
+    ImGuiStorage() : DataCount(0), ZeroKeyUsed(false), ZeroKeyPair(0, 0) {}
+    void                Clear() { Data.clear(); DataCount = 0; ZeroKeyUsed = false; }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1762,6 +1832,7 @@ struct ImGuiStorage
 
     // - Get***Ref() functions finds pair, insert on demand if missing, return pointer. Useful if you intend to do Get+Set.
     // - References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+    //   (this is true for both the default sorted storage and IMGUI_USE_HASHED_STORAGE. Calls not adding a new key never invalidate references.)
     // - A typical use case where this is convenient for quick hacking (e.g. add storage during a live Edit&Continue session if you can't modify existing struct)
     //      float* pvar = ImGui::GetFloatRef(key); ImGui::SliderFloat("var", pvar, 0, 100.0f); some_var += *pvar;
     IMGUI_API int*      GetIntRef(ImGuiID key, int default_val = 0);
@@ -1773,6 +1844,7 @@ struct ImGuiStorage
     IMGUI_API void      SetAllInt(int val);
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // With IMGUI_USE_HASHED_STORAGE this rebuilds the hash table from all pairs in Data[] instead (pairs with a zero key are ignored, use SetXXX() for them).
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -1895,8 +1967,43 @@ struct ImDrawCmd
 typedef unsigned short ImDrawIdx;
 #endif
 
+// Compact vertex attributes, used by ImDrawVert when IMGUI_USE_COMPACT_DRAWVERT is defined in imconfig.h.
+// They are assigned from/converted to ImVec2, so vertex writers and readers are the same code for both layouts.
+// - ImDrawVertPos16: signed 16-bit fixed point with IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS fractional bits, rounded to nearest, clamped to +/-32767.
+//   Renderer back-ends read them as non-normalized integers and scale them by 1/IMGUI_COMPACT_DRAWVERT_POS_SCALE in their projection matrix.
+// - ImDrawVertUV16: normalized unsigned 16-bit (0..65535 maps to 0.0f..1.0f), rounded to nearest, clamped to [0,1].
+#ifndef IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS
+#define IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS    2
+#endif
+#define IMGUI_COMPACT_DRAWVERT_POS_SCALE        ((float)(1 << IMGUI_COMPACT_DRAWVERT_POS_FRAC_BITS))
+
+struct ImDrawVertPos16
+{
+    ImS16   x, y;
+    ImDrawVertPos16&    operator=(const ImVec2& v)  { x = Encode(v.x); y = Encode(v.y); return *this; }
+    operator            ImVec2() const              { return ImVec2(x * (1.0f / IMGUI_COMPACT_DRAWVERT_POS_SCALE), y * (1.0f / IMGUI_COMPACT_DRAWVERT_POS_SCALE)); }
+    static ImS16        Encode(float f)             { f *= IMGUI_COMPACT_DRAWVERT_POS_SCALE; f = f > 32767.0f ? 32767.0f : f; f = f < -32767.0f ? -32767.0f : f; const int i = (int)f; const float r = f - (float)i; return (ImS16)(i + (r >= 0.5f) - (r <= -0.5f)); } // Branchless
+};
+
+struct ImDrawVertUV16
+{
+    ImU16   x, y;
+    ImDrawVertUV16&     operator=(const ImVec2& v)  { x = Encode(v.x); y = Encode(v.y); return *this; }
+    operator            ImVec2() const              { return ImVec2(x * (1.0f / 65535.0f), y * (1.0f / 65535.0f)); }
+    static ImU16        Encode(float f)             { f = f > 1.0f ? 1.0f : f; f = f < 0.0f ? 0.0f : f; return (ImU16)(int)(f * 65535.0f + 0.5f); }
+};
+
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#if defined(IMGUI_USE_COMPACT_DRAWVERT) && defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#error "IMGUI_USE_COMPACT_DRAWVERT and IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT are mutually exclusive."
+#elif defined(IMGUI_USE_COMPACT_DRAWVERT)
+struct ImDrawVert
+{
+    ImDrawVertPos16 pos;
+    ImDrawVertUV16  uv;
+    ImU32           col;
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
@@ -1954,7 +2061,9 @@ enum ImDrawListFlags_
     ImDrawListFlags_None             = 0,
     ImDrawListFlags_AntiAliasedLines = 1 << 0,  // Lines are anti-aliased (*2 the number of triangles for 1.0f wide line, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedFill  = 1 << 1,  // Filled shapes have anti-aliased edges (*2 the number of vertices)
-    ImDrawListFlags_AllowVtxOffset   = 1 << 2   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset   = 1 << 2,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_DeferTessellation= 1 << 3,  // AddPolyline(), AddConvexPolyFilled() and AddText() only reserve their vertices, which are generated later by _FlushDeferred(). Set on window draw lists when 'io.ConfigDrawListsDeferTessellation' is enabled.
+    ImDrawListFlags_CpuClipRect      = 1 << 4   // Pushing a clip rectangle contained in the one of the current draw command doesn't add a command: AddRectFilled() without rounding, AddImage() and AddText() are clipped on the CPU (adjusting UVs) and keep using the current command, other primitives add a new command. Set on window draw lists when 'io.ConfigDrawListsCpuClipRect' is enabled.
 };
 
 // Draw command list
@@ -1984,9 +2093,14 @@ struct ImDrawList
     ImVector<ImTextureID>   _TextureIdStack;    // [Internal]
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api
+    ImDrawListDeferred*     _Deferred;          // [Internal] primitives waiting to be tessellated (with ImDrawListFlags_DeferTessellation)
+    int                     _VtxPeakSize;       // [Internal] largest VtxBuffer.Size since the last shrink check (see io.ConfigDrawListsShrinkFrames)
+    int                     _IdxPeakSize;       // [Internal] largest IdxBuffer.Size since the last shrink check
+    int                     _PeakFrames;        // [Internal] number of frames (calls to Clear()) since the last shrink check
+    bool                    _ModifiedAfterRender; // [Internal] buffers were modified by ImDrawData::DeIndexAllBuffers()/ScaleClipRects(), see ImGuiWindowFlags_CacheContents
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
-    ImDrawList(const ImDrawListSharedData* shared_data) { _Data = shared_data; _OwnerName = NULL; Clear(); }
+    ImDrawList(const ImDrawListSharedData* shared_data) { _Data = shared_data; _OwnerName = NULL; _Deferred = NULL; _VtxPeakSize = _IdxPeakSize = _PeakFrames = 0; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  PushClipRect(ImVec2 clip_rect_min, ImVec2 clip_rect_max, bool intersect_with_current_clip_rect = false);  // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
     IMGUI_API void  PushClipRectFullScreen();
@@ -2018,6 +2132,7 @@ struct ImDrawList
     IMGUI_API void  AddPolyline(const ImVec2* points, int num_points, ImU32 col, bool closed, float thickness);
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col); // Note: Anti-aliased filling requires points to be in clockwise order.
     IMGUI_API void  AddBezierCurve(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0);
+    IMGUI_API void  AddPolylineStrided(const float* xs, const float* ys, int count, int stride, const ImVec2& offset, const ImVec2& scale, ImU32 col, float thickness = 1.0f);  // Plot samples at 'offset + (xs[n], ys[n]) * scale'. xs==NULL for x = n. Stride in bytes. Culls against current clip rect, NaN leaves a gap, decimates to min/max per pixel column.
 
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
@@ -2065,6 +2180,11 @@ struct ImDrawList
     inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col){ _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                 { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
+    IMGUI_API void  _PrimPolyline(const ImVec2* points, int points_count, ImU32 col, bool closed, float thickness, bool anti_aliased);  // Fill vertices/indices reserved by AddPolyline()
+    IMGUI_API void  _PrimConvexPolyFilled(const ImVec2* points, int points_count, ImU32 col, bool anti_aliased);                      // Fill vertices/indices reserved by AddConvexPolyFilled()
+    IMGUI_API bool  _PrimRectCpuClipped(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col);          // With ImDrawListFlags_CpuClipRect: when the current command doesn't use the current clip rectangle, output the rectangle clipped on the CPU and return true
+    IMGUI_API void  _FlushDeferred();                                           // Generate vertices of primitives recorded with ImDrawListFlags_DeferTessellation. Safe to call on different draw lists from different threads.
+    IMGUI_API void  _ResizeBuffersForNewFrame();                                // Called by Clear(): grow or shrink empty VtxBuffer/IdxBuffer based on their previous usage (see io.ConfigDrawListsShrinkFrames, io.ConfigDrawListsPreSize)
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
 };
@@ -2083,10 +2203,20 @@ struct ImDrawData
     ImVec2          DisplaySize;            // Size of the viewport to render (== io.DisplaySize for the main viewport) (DisplayPos + DisplaySize == lower-right of the orthogonal projection matrix to use)
     ImVec2          FramebufferScale;       // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
 
+    // Arena: only set when 'io.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena', NULL otherwise.
+    // The vertices/indices of all CmdLists[] are copied into single buffers, so the back-end can upload the frame at once.
+    // The commands of CmdLists[n] are the next CmdLists[n]->CmdBuffer.Size commands of ArenaCmdBuffer[], with VtxOffset/IdxOffset relative to the arena buffers.
+    // With io.ConfigDrawDataMergeCommands, a command may extend over the commands of following draw lists, which are then left with ElemCount == 0: skip them.
+    // The arena is a copy of CmdLists[] as of Render(): ScaleClipRects() also scales its clip rectangles, DeIndexAllBuffers() clears it (Arena* set to NULL/0).
+    ImDrawVert*     ArenaVtxBuffer;         // TotalVtxCount vertices (owned by ImGuiContext, or provided by io.DrawDataArenaAllocFn)
+    ImDrawIdx*      ArenaIdxBuffer;         // TotalIdxCount indices (owned by ImGuiContext, or provided by io.DrawDataArenaAllocFn)
+    ImDrawCmd*      ArenaCmdBuffer;         // Copy of the commands of all CmdLists[] (owned by ImGuiContext)
+    int             ArenaCmdCount;          // Number of ImDrawCmd in ArenaCmdBuffer
+
     // Functions
     ImDrawData()    { Valid = false; Clear(); }
     ~ImDrawData()   { Clear(); }
-    void Clear()    { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.f, 0.f); } // The ImDrawList are owned by ImGuiContext!
+    void Clear()    { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.f, 0.f); ArenaVtxBuffer = NULL; ArenaIdxBuffer = NULL; ArenaCmdBuffer = NULL; ArenaCmdCount = 0; } // The ImDrawList are owned by ImGuiContext!
     IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
@@ -2264,6 +2394,7 @@ struct ImFontAtlas
     int                         TexHeight;          // Texture height calculated during Build().
     ImVec2                      TexUvScale;         // = (1.0f/TexWidth, 1.0f/TexHeight)
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
+    int                         BuildCount;         // Incremented by each build, so data derived from glyphs can be invalidated (e.g. io.ConfigTextCacheBudget)
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Internal data
@@ -401,6 +401,12 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::Checkbox("io.ConfigWindowsResizeFromEdges", &io.ConfigWindowsResizeFromEdges);
             ImGui::SameLine(); HelpMarker("Enable resizing of windows from their edges and from the lower-left corner.\nThis requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback.");
             ImGui::Checkbox("io.ConfigWindowsMoveFromTitleBarOnly", &io.ConfigWindowsMoveFromTitleBarOnly);
+            ImGui::Checkbox("io.ConfigDrawListsDeferTessellation", &io.ConfigDrawListsDeferTessellation);
+            ImGui::SameLine(); HelpMarker("Generate vertices for lines, convex fills and text of window draw lists in Render().\nEach window draw list is processed with io.ParallelForFn when set.");
+            ImGui::Checkbox("io.ConfigDrawListsCpuClipRect", &io.ConfigDrawListsCpuClipRect);
+            ImGui::SameLine(); HelpMarker("Clip text, images and rectangles on the CPU when they are in a clip rectangle nested in the one of the current draw command (e.g. columns), so they don't need a new draw command.");
+            ImGui::Checkbox("io.ConfigDrawDataMergeCommands", &io.ConfigDrawDataMergeCommands);
+            ImGui::SameLine(); HelpMarker("Merge consecutive draw commands of different windows using the same texture, when their clip rectangles are equal or don't clip anything.\nRequires a renderer back-end using the draw data arena (io.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena).");
             ImGui::Checkbox("io.MouseDrawCursor", &io.MouseDrawCursor);
             ImGui::SameLine(); HelpMarker("Instruct Dear ImGui to render a mouse cursor itself. Note that a mouse cursor rendered via your application GPU rendering path will feel more laggy than hardware cursor, but will be more in sync with your other visuals.\n\nSome desktop applications may use both kinds of cursors (e.g. enable software cursor only when resizing/dragging something).");
             ImGui::TreePop();
@@ -419,6 +425,7 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::CheckboxFlags("io.BackendFlags: HasMouseCursors",      (unsigned int *)&backend_flags, ImGuiBackendFlags_HasMouseCursors);
             ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",       (unsigned int *)&backend_flags, ImGuiBackendFlags_HasSetMousePos);
             ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset", (unsigned int *)&backend_flags, ImGuiBackendFlags_RendererHasVtxOffset);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasDrawDataArena", (unsigned int *)&backend_flags, ImGuiBackendFlags_RendererHasDrawDataArena);
             ImGui::TreePop();
             ImGui::Separator();
         }
@@ -3461,11 +3468,19 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.ConfigWindowsResizeFromEdges)                            ImGui::Text("io.ConfigWindowsResizeFromEdges");
         if (io.ConfigWindowsMoveFromTitleBarOnly)                       ImGui::Text("io.ConfigWindowsMoveFromTitleBarOnly");
         if (io.ConfigWindowsMemoryCompactTimer >= 0.0f)                 ImGui::Text("io.ConfigWindowsMemoryCompactTimer = %.1ff", io.ConfigWindowsMemoryCompactTimer);
+        if (io.ConfigMemoryCompactBudget > 0)                           ImGui::Text("io.ConfigMemoryCompactBudget = %d", io.ConfigMemoryCompactBudget);
+        if (io.ConfigDrawListsDeferTessellation)                        ImGui::Text("io.ConfigDrawListsDeferTessellation");
+        if (io.ConfigDrawListsShrinkFrames > 0)                         ImGui::Text("io.ConfigDrawListsShrinkFrames = %d", io.ConfigDrawListsShrinkFrames);
+        if (io.ConfigDrawListsPreSize)                                  ImGui::Text("io.ConfigDrawListsPreSize");
+        if (io.ConfigDrawListsCpuClipRect)                              ImGui::Text("io.ConfigDrawListsCpuClipRect");
+        if (io.ConfigDrawDataMergeCommands)                             ImGui::Text("io.ConfigDrawDataMergeCommands");
+        if (io.ParallelForFn)                                           ImGui::Text("io.ParallelForFn");
         ImGui::Text("io.BackendFlags: 0x%08X", io.BackendFlags);
         if (io.BackendFlags & ImGuiBackendFlags_HasGamepad)             ImGui::Text(" HasGamepad");
         if (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors)        ImGui::Text(" HasMouseCursors");
         if (io.BackendFlags & ImGuiBackendFlags_HasSetMousePos)         ImGui::Text(" HasSetMousePos");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)   ImGui::Text(" RendererHasVtxOffset");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasDrawDataArena) ImGui::Text(" RendererHasDrawDataArena");
         ImGui::Separator();
         ImGui::Text("io.Fonts: %d fonts, Flags: 0x%08X, TexSize: %d,%d", io.Fonts->Fonts.Size, io.Fonts->Flags, io.Fonts->TexWidth, io.Fonts->TexHeight);
         ImGui::Text("io.DisplaySize: %.2f,%.2f", io.DisplaySize.x, io.DisplaySize.y);
@@ -16,6 +16,7 @@ Index of this file:
 // [SECTION] ImFontAtlas glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
 // [SECTION] ImFont
+// [SECTION] ImFontTextCache
 // [SECTION] ImGui Internal Render Helpers
 // [SECTION] Decompression code
 // [SECTION] Default font data (ProggyClean.ttf)
@@ -353,6 +354,9 @@ ImDrawListSharedData::ImDrawListSharedData()
     CircleSegmentMaxError = 0.0f;
     ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, +8192.0f, +8192.0f);
     InitialFlags = ImDrawListFlags_None;
+    TextCache = NULL;
+    BuffersShrinkFrames = 0;
+    BuffersPreSize = false;
 
     // Lookup tables
     for (int i = 0; i < IM_ARRAYSIZE(ArcFastVtx); i++)
@@ -378,6 +382,8 @@ void ImDrawListSharedData::SetCircleSegmentMaxError(float max_error)
 
 void ImDrawList::Clear()
 {
+    if (_Data && (_Data->BuffersShrinkFrames > 0 || _Data->BuffersPreSize))
+        _ResizeBuffersForNewFrame();
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
@@ -390,6 +396,9 @@ void ImDrawList::Clear()
     _TextureIdStack.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
+    if (_Deferred)
+        _Deferred->Clear();
+    _ModifiedAfterRender = false;
 }
 
 void ImDrawList::ClearFreeMemory()
@@ -404,10 +413,53 @@ void ImDrawList::ClearFreeMemory()
     _TextureIdStack.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    IM_DELETE(_Deferred);
+    _Deferred = NULL;
+    _VtxPeakSize = _IdxPeakSize = _PeakFrames = 0;
+}
+
+// Reallocate an empty buffer, which doesn't need to copy anything
+template<typename T>
+static void ReallocEmptyBuffer(ImVector<T>& buf, int capacity)
+{
+    buf.clear();
+    buf.reserve(capacity);
+}
+
+// Called by Clear() with the contents of the previous frame, which are about to be discarded.
+// - BuffersPreSize: buffers filled over 3/4 grow by 50%, so a frame using a little more doesn't grow them while adding primitives,
+//   which copies their contents (the repeated copies of a 1.5x growth policy are about twice the final size of the buffer).
+// - BuffersShrinkFrames: buffers whose peak usage stayed under 1/4 of their capacity during that many frames shrink to 1.5x that peak.
+//   The gap between both thresholds avoids reallocating every frame when usage oscillates.
+void ImDrawList::_ResizeBuffersForNewFrame()
+{
+    const int vtx_size = VtxBuffer.Size;
+    const int idx_size = IdxBuffer.Size;
+    if (_Data->BuffersPreSize)
+    {
+        if (vtx_size > VtxBuffer.Capacity - VtxBuffer.Capacity / 4)
+            ReallocEmptyBuffer(VtxBuffer, vtx_size + vtx_size / 2);
+        if (idx_size > IdxBuffer.Capacity - IdxBuffer.Capacity / 4)
+            ReallocEmptyBuffer(IdxBuffer, idx_size + idx_size / 2);
+    }
+    if (_Data->BuffersShrinkFrames > 0)
+    {
+        _VtxPeakSize = ImMax(_VtxPeakSize, vtx_size);
+        _IdxPeakSize = ImMax(_IdxPeakSize, idx_size);
+        if (++_PeakFrames >= _Data->BuffersShrinkFrames)
+        {
+            if (VtxBuffer.Capacity / 4 > _VtxPeakSize)
+                ReallocEmptyBuffer(VtxBuffer, _VtxPeakSize + _VtxPeakSize / 2);
+            if (IdxBuffer.Capacity / 4 > _IdxPeakSize)
+                ReallocEmptyBuffer(IdxBuffer, _IdxPeakSize + _IdxPeakSize / 2);
+            _VtxPeakSize = _IdxPeakSize = _PeakFrames = 0;
+        }
+    }
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
 {
+    const_cast<ImDrawList*>(this)->_FlushDeferred();
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
@@ -422,6 +474,7 @@ ImDrawList* ImDrawList::CloneOutput() const
 
 void ImDrawList::AddDrawCmd()
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
@@ -446,6 +499,11 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
     AddDrawCmd(); // Force a new command after us (see comment below)
 }
 
+static inline bool ImClipRectContains(const ImVec4& outer, const ImVec4& inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y && inner.z <= outer.z && inner.w <= outer.w;
+}
+
 // Our scheme may appears a bit unusual, basically we want the most-common calls AddLine AddRect etc. to not have to perform any check so we always have a command ready in the stack.
 // The cost of figuring out if a new command has to be added or if we can merge is paid in those Update** functions only.
 void ImDrawList::UpdateClipRect()
@@ -453,6 +511,21 @@ void ImDrawList::UpdateClipRect()
     // If current command is used with different settings we need to add a new command
     const ImVec4 curr_clip_rect = GetCurrentClipRect();
     ImDrawCmd* curr_cmd = CmdBuffer.Size > 0 ? &CmdBuffer.Data[CmdBuffer.Size-1] : NULL;
+
+    // With ImDrawListFlags_CpuClipRect, a clip rectangle contained in the one of the current (or previous, if the current one is empty) command
+    // doesn't need a new command yet: primitives clipped on the CPU keep using it, other primitives will add a command in PrimReserve().
+    if ((Flags & ImDrawListFlags_CpuClipRect) && curr_cmd && curr_cmd->UserCallback == NULL)
+    {
+        ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
+        if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->UserCallback == NULL && prev_cmd->TextureId == curr_cmd->TextureId && prev_cmd->VtxOffset == curr_cmd->VtxOffset && ImClipRectContains(prev_cmd->ClipRect, curr_clip_rect))
+        {
+            CmdBuffer.pop_back();
+            return;
+        }
+        if (ImClipRectContains(curr_cmd->ClipRect, curr_clip_rect))
+            return;
+    }
+
     if (!curr_cmd || (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &curr_clip_rect, sizeof(ImVec4)) != 0) || curr_cmd->UserCallback != NULL)
     {
         AddDrawCmd();
@@ -472,15 +545,21 @@ void ImDrawList::UpdateTextureID()
     // If current command is used with different settings we need to add a new command
     const ImTextureID curr_texture_id = GetCurrentTextureId();
     ImDrawCmd* curr_cmd = CmdBuffer.Size ? &CmdBuffer.back() : NULL;
+    const bool cpu_clip_rect = (Flags & ImDrawListFlags_CpuClipRect) != 0;
     if (!curr_cmd || (curr_cmd->ElemCount != 0 && curr_cmd->TextureId != curr_texture_id) || curr_cmd->UserCallback != NULL)
     {
+        // With ImDrawListFlags_CpuClipRect, keep using the larger clip rectangle of the current command (see UpdateClipRect())
+        const bool keep_clip_rect = cpu_clip_rect && curr_cmd && curr_cmd->UserCallback == NULL && ImClipRectContains(curr_cmd->ClipRect, GetCurrentClipRect());
+        const ImVec4 keep_clip_rect_value = keep_clip_rect ? curr_cmd->ClipRect : ImVec4();
         AddDrawCmd();
+        if (keep_clip_rect)
+            CmdBuffer.back().ClipRect = keep_clip_rect_value;
         return;
     }
 
     // Try to merge with previous command if it matches, else use current command
     ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
-    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 && prev_cmd->UserCallback == NULL)
+    if (curr_cmd->ElemCount == 0 && prev_cmd && prev_cmd->TextureId == curr_texture_id && prev_cmd->UserCallback == NULL && (memcmp(&prev_cmd->ClipRect, &GetCurrentClipRect(), sizeof(ImVec4)) == 0 || (cpu_clip_rect && prev_cmd->VtxOffset == curr_cmd->VtxOffset && ImClipRectContains(prev_cmd->ClipRect, GetCurrentClipRect()))))
         CmdBuffer.pop_back();
     else
         curr_cmd->TextureId = curr_texture_id;
@@ -492,6 +571,7 @@ void ImDrawList::UpdateTextureID()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect && _ClipRectStack.Size)
     {
@@ -522,6 +602,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     _TextureIdStack.push_back(texture_id);
     UpdateTextureID();
 }
@@ -538,6 +619,7 @@ void ImDrawList::PopTextureID()
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
@@ -547,8 +629,24 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
         AddDrawCmd();
     }
 
-    ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size - 1];
-    draw_cmd.ElemCount += idx_count;
+    // With ImDrawListFlags_CpuClipRect the current command may use a larger clip rectangle than the current one (see UpdateClipRect()),
+    // primitives which are not clipped on the CPU need a command using the current clip rectangle.
+    ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (Flags & ImDrawListFlags_CpuClipRect)
+    {
+        const ImVec4& clip_rect = _ClipRectStack.Size ? _ClipRectStack.Data[_ClipRectStack.Size - 1] : _Data->ClipRectFullscreen;
+        if (memcmp(&draw_cmd->ClipRect, &clip_rect, sizeof(ImVec4)) != 0)
+        {
+            if (draw_cmd->ElemCount == 0)
+                draw_cmd->ClipRect = clip_rect;
+            else
+            {
+                AddDrawCmd();
+                draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+            }
+        }
+    }
+    draw_cmd->ElemCount += idx_count;
 
     int vtx_buffer_old_size = VtxBuffer.Size;
     VtxBuffer.resize(vtx_buffer_old_size + vtx_count);
@@ -601,6 +699,39 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
     _IdxWritePtr += 6;
 }
 
+// With ImDrawListFlags_CpuClipRect: when the current command uses a larger clip rectangle than the current one, clip the rectangle on the CPU
+// (adjusting UVs) and output it in the current command. Return false if the rectangle needs to be output normally.
+bool ImDrawList::_PrimRectCpuClipped(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
+{
+    const ImVec4& clip_rect = _ClipRectStack.Size ? _ClipRectStack.Data[_ClipRectStack.Size - 1] : _Data->ClipRectFullscreen;
+    if (memcmp(&CmdBuffer.Data[CmdBuffer.Size - 1].ClipRect, &clip_rect, sizeof(ImVec4)) == 0 || a.x > c.x || a.y > c.y)
+        return false;
+
+    ImVec2 clipped_a(ImMax(a.x, clip_rect.x), ImMax(a.y, clip_rect.y));
+    ImVec2 clipped_c(ImMin(c.x, clip_rect.z), ImMin(c.y, clip_rect.w));
+    if (clipped_a.x >= clipped_c.x || clipped_a.y >= clipped_c.y)
+        return true;
+    ImVec2 clipped_uv_a = uv_a, clipped_uv_c = uv_c;
+    if (clipped_a.x != a.x || clipped_c.x != c.x)
+    {
+        const float uv_per_x = (uv_c.x - uv_a.x) / (c.x - a.x);
+        clipped_uv_a.x = uv_a.x + (clipped_a.x - a.x) * uv_per_x;
+        clipped_uv_c.x = uv_c.x + (clipped_c.x - c.x) * uv_per_x;
+    }
+    if (clipped_a.y != a.y || clipped_c.y != c.y)
+    {
+        const float uv_per_y = (uv_c.y - uv_a.y) / (c.y - a.y);
+        clipped_uv_a.y = uv_a.y + (clipped_a.y - a.y) * uv_per_y;
+        clipped_uv_c.y = uv_c.y + (clipped_c.y - c.y) * uv_per_y;
+    }
+
+    Flags &= ~ImDrawListFlags_CpuClipRect; // Don't let PrimReserve() add a command
+    PrimReserve(6, 4);
+    Flags |= ImDrawListFlags_CpuClipRect;
+    PrimRectUV(clipped_a, clipped_c, clipped_uv_a, clipped_uv_c, col);
+    return true;
+}
+
 void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col)
 {
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
@@ -620,28 +751,332 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     do { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } } while (0)
 #define IM_FIXNORMAL2F(VX,VY)               do { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; } while (0)
 
-// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
-// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+static void RenderTextGlyphs(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, float y, ImU32 col, const ImVec4& clip_rect, const char* s, const char* text_end, float wrap_width, bool cpu_fine_clip);
+static bool RenderTextCached(const ImFont* font, ImDrawList* draw_list, ImFontTextCache* cache, ImFontTextCacheEntry* entry, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end);
+
+// With ImDrawListFlags_DeferTessellation: record a primitive whose vertices/indices have just been reserved with PrimReserve(), and skip over them.
+static ImDrawListDeferredCmd* DeferPrimitive(ImDrawList* draw_list, ImDrawListDeferredCmdType type, int idx_count, int vtx_count)
+{
+    IMGUI_ALLOC_SCOPE("ImDrawList");
+    if (draw_list->_Deferred == NULL)
+        draw_list->_Deferred = IM_NEW(ImDrawListDeferred)();
+    ImDrawListDeferred* deferred = draw_list->_Deferred;
+    deferred->Cmds.resize(deferred->Cmds.Size + 1);
+    ImDrawListDeferredCmd* cmd = &deferred->Cmds.back();
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->Type = (ImU8)type;
+    cmd->VtxOffset = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data);
+    cmd->IdxOffset = (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+    cmd->VtxCount = vtx_count;
+    cmd->IdxCount = idx_count;
+    cmd->VtxCurrentIdx = draw_list->_VtxCurrentIdx;
+    draw_list->_VtxWritePtr += vtx_count;
+    draw_list->_IdxWritePtr += idx_count;
+    draw_list->_VtxCurrentIdx += vtx_count;
+    return cmd;
+}
+
+static ImDrawListDeferredCmd* DeferPrimitiveWithPoints(ImDrawList* draw_list, ImDrawListDeferredCmdType type, int idx_count, int vtx_count, const ImVec2* points, int points_count)
+{
+    IMGUI_ALLOC_SCOPE("ImDrawList");
+    ImDrawListDeferredCmd* cmd = DeferPrimitive(draw_list, type, idx_count, vtx_count);
+    ImVector<ImVec2>& deferred_points = draw_list->_Deferred->Points;
+    cmd->DataOffset = deferred_points.Size;
+    cmd->DataSize = points_count;
+    deferred_points.resize(deferred_points.Size + points_count);
+    memcpy(deferred_points.Data + cmd->DataOffset, points, (size_t)points_count * sizeof(ImVec2));
+    return cmd;
+}
+
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
 {
     if (points_count < 2)
         return;
 
+    const int count = closed ? points_count : points_count-1;
+    const bool thick_line = (thickness > 1.0f);
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    const int idx_count = anti_aliased ? (thick_line ? count*18 : count*12) : count*6;
+    const int vtx_count = anti_aliased ? (thick_line ? points_count*4 : points_count*3) : count*4;      // FIXME-OPT: Not sharing edges when not anti-aliased
+    PrimReserve(idx_count, vtx_count);
+
+    if (Flags & ImDrawListFlags_DeferTessellation)
+    {
+        ImDrawListDeferredCmd* cmd = DeferPrimitiveWithPoints(this, ImDrawListDeferredCmdType_Polyline, idx_count, vtx_count, points, points_count);
+        cmd->Col = col;
+        cmd->Size = thickness;
+        cmd->Closed = closed;
+        cmd->AntiAliased = anti_aliased;
+        return;
+    }
+    _PrimPolyline(points, points_count, col, closed, thickness, anti_aliased);
+}
+
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+
+// Minimal wrappers over 4-wide float vectors, used to process two ImVec2 (x0,y0,x1,y1) at a time.
+// We only use IEEE exact operations (no reciprocal approximations, no fused multiply-add) so the output is identical to the scalar code.
+#if defined(IMGUI_ENABLE_SSE)
+typedef __m128 ImFloat4;
+static inline ImFloat4  ImFloat4Load(const float* p)                            { return _mm_loadu_ps(p); }
+static inline void      ImFloat4Store(float* p, ImFloat4 v)                     { _mm_storeu_ps(p, v); }
+static inline void      ImFloat4StoreLo(float* p, ImFloat4 v)                   { _mm_storel_pi((__m64*)(void*)p, v); }
+static inline void      ImFloat4StoreHi(float* p, ImFloat4 v)                   { _mm_storeh_pi((__m64*)(void*)p, v); }
+static inline ImFloat4  ImFloat4Set1(float f)                                   { return _mm_set1_ps(f); }
+static inline ImFloat4  ImFloat4Set(float x, float y, float z, float w)         { return _mm_setr_ps(x, y, z, w); }
+static inline ImFloat4  ImFloat4Add(ImFloat4 a, ImFloat4 b)                     { return _mm_add_ps(a, b); }
+static inline ImFloat4  ImFloat4Sub(ImFloat4 a, ImFloat4 b)                     { return _mm_sub_ps(a, b); }
+static inline ImFloat4  ImFloat4Mul(ImFloat4 a, ImFloat4 b)                     { return _mm_mul_ps(a, b); }
+static inline ImFloat4  ImFloat4Div(ImFloat4 a, ImFloat4 b)                     { return _mm_div_ps(a, b); }
+static inline ImFloat4  ImFloat4Sqrt(ImFloat4 a)                                { return _mm_sqrt_ps(a); }
+static inline ImFloat4  ImFloat4Max(ImFloat4 a, ImFloat4 b)                     { return _mm_max_ps(a, b); }   // a > b ? a : b
+static inline ImFloat4  ImFloat4SwapPairs(ImFloat4 v)                           { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline ImFloat4  ImFloat4SelectGreaterThanZero(ImFloat4 c, ImFloat4 a, ImFloat4 b) { __m128 mask = _mm_cmpgt_ps(c, _mm_setzero_ps()); return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#else
+typedef float32x4_t ImFloat4;
+static inline ImFloat4  ImFloat4Load(const float* p)                            { return vld1q_f32(p); }
+static inline void      ImFloat4Store(float* p, ImFloat4 v)                     { vst1q_f32(p, v); }
+static inline void      ImFloat4StoreLo(float* p, ImFloat4 v)                   { vst1_f32(p, vget_low_f32(v)); }
+static inline void      ImFloat4StoreHi(float* p, ImFloat4 v)                   { vst1_f32(p, vget_high_f32(v)); }
+static inline ImFloat4  ImFloat4Set1(float f)                                   { return vdupq_n_f32(f); }
+static inline ImFloat4  ImFloat4Set(float x, float y, float z, float w)         { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+static inline ImFloat4  ImFloat4Add(ImFloat4 a, ImFloat4 b)                     { return vaddq_f32(a, b); }
+static inline ImFloat4  ImFloat4Sub(ImFloat4 a, ImFloat4 b)                     { return vsubq_f32(a, b); }
+static inline ImFloat4  ImFloat4Mul(ImFloat4 a, ImFloat4 b)                     { return vmulq_f32(a, b); }
+static inline ImFloat4  ImFloat4Div(ImFloat4 a, ImFloat4 b)                     { return vdivq_f32(a, b); }
+static inline ImFloat4  ImFloat4Sqrt(ImFloat4 a)                                { return vsqrtq_f32(a); }
+static inline ImFloat4  ImFloat4Max(ImFloat4 a, ImFloat4 b)                     { return vbslq_f32(vcgtq_f32(a, b), a, b); }   // a > b ? a : b
+static inline ImFloat4  ImFloat4SwapPairs(ImFloat4 v)                           { return vrev64q_f32(v); }
+static inline ImFloat4  ImFloat4SelectGreaterThanZero(ImFloat4 c, ImFloat4 a, ImFloat4 b) { return vbslq_f32(vcgtq_f32(c, vdupq_n_f32(0.0f)), a, b); }
+#endif
+
+// Store the low (x0,y0) and high (x1,y1) halves of a vector into the positions of two vertices.
+// With IMGUI_USE_COMPACT_DRAWVERT this uses the same rounding and clamping as ImDrawVertPos16::Encode(), so the output is identical to the scalar code.
+#if !defined(IMGUI_USE_COMPACT_DRAWVERT)
+static inline void      ImFloat4StorePos(ImDrawVert* vtx_lo, ImDrawVert* vtx_hi, ImFloat4 v) { ImFloat4StoreLo(&vtx_lo->pos.x, v); ImFloat4StoreHi(&vtx_hi->pos.x, v); }
+#elif defined(IMGUI_ENABLE_SSE)
+static inline void      ImFloat4StorePos(ImDrawVert* vtx_lo, ImDrawVert* vtx_hi, ImFloat4 v)
+{
+    __m128 f = _mm_mul_ps(v, _mm_set1_ps(IMGUI_COMPACT_DRAWVERT_POS_SCALE));
+    f = _mm_max_ps(_mm_min_ps(f, _mm_set1_ps(32767.0f)), _mm_set1_ps(-32767.0f));
+    const __m128i t = _mm_cvttps_epi32(f);
+    const __m128 r = _mm_sub_ps(f, _mm_cvtepi32_ps(t));                                     // Round half away from zero: add/subtract 1 when the remainder is >= 0.5
+    const __m128i i = _mm_add_epi32(_mm_sub_epi32(t, _mm_castps_si128(_mm_cmpge_ps(r, _mm_set1_ps(0.5f)))), _mm_castps_si128(_mm_cmple_ps(r, _mm_set1_ps(-0.5f))));
+    const __m128i packed = _mm_packs_epi32(i, i);
+    const int lo = _mm_cvtsi128_si32(packed), hi = _mm_cvtsi128_si32(_mm_srli_si128(packed, 4));
+    memcpy(&vtx_lo->pos, &lo, sizeof(ImDrawVertPos16));
+    memcpy(&vtx_hi->pos, &hi, sizeof(ImDrawVertPos16));
+}
+#else
+static inline void      ImFloat4StorePos(ImDrawVert* vtx_lo, ImDrawVert* vtx_hi, ImFloat4 v)
+{
+    float32x4_t f = vmulq_f32(v, vdupq_n_f32(IMGUI_COMPACT_DRAWVERT_POS_SCALE));
+    f = vmaxq_f32(vminq_f32(f, vdupq_n_f32(32767.0f)), vdupq_n_f32(-32767.0f));
+    const int32x4_t t = vcvtq_s32_f32(f);
+    const float32x4_t r = vsubq_f32(f, vcvtq_f32_s32(t));                                   // Round half away from zero: add/subtract 1 when the remainder is >= 0.5
+    const int32x4_t i = vaddq_s32(vsubq_s32(t, vreinterpretq_s32_u32(vcgeq_f32(r, vdupq_n_f32(0.5f)))), vreinterpretq_s32_u32(vcleq_f32(r, vdupq_n_f32(-0.5f))));
+    const uint32x2_t packed = vreinterpret_u32_s16(vqmovn_s32(i));
+    const ImU32 lo = vget_lane_u32(packed, 0), hi = vget_lane_u32(packed, 1);
+    memcpy(&vtx_lo->pos, &lo, sizeof(ImDrawVertPos16));
+    memcpy(&vtx_hi->pos, &hi, sizeof(ImDrawVertPos16));
+}
+#endif
+
+// Output the 3 (thin line) or 4 (thick line) vertices of a point given its offset direction 'dm'
+static inline void PolylineWritePointVertices(ImDrawVert* vtx, const ImVec2& p, float dm_x, float dm_y, bool thick_line, float half_inner_thickness, const ImVec2& uv, ImU32 col, ImU32 col_trans)
+{
+    const float AA_SIZE = 1.0f;
+    if (!thick_line)
+    {
+        dm_x *= AA_SIZE;
+        dm_y *= AA_SIZE;
+        vtx[0].pos = p;                              vtx[0].uv = uv; vtx[0].col = col;
+        vtx[1].pos = ImVec2(p.x + dm_x, p.y + dm_y); vtx[1].uv = uv; vtx[1].col = col_trans;
+        vtx[2].pos = ImVec2(p.x - dm_x, p.y - dm_y); vtx[2].uv = uv; vtx[2].col = col_trans;
+    }
+    else
+    {
+        const float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+        const float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+        const float dm_in_x = dm_x * half_inner_thickness;
+        const float dm_in_y = dm_y * half_inner_thickness;
+        vtx[0].pos = ImVec2(p.x + dm_out_x, p.y + dm_out_y); vtx[0].uv = uv; vtx[0].col = col_trans;
+        vtx[1].pos = ImVec2(p.x + dm_in_x, p.y + dm_in_y);   vtx[1].uv = uv; vtx[1].col = col;
+        vtx[2].pos = ImVec2(p.x - dm_in_x, p.y - dm_in_y);   vtx[2].uv = uv; vtx[2].col = col;
+        vtx[3].pos = ImVec2(p.x - dm_out_x, p.y - dm_out_y); vtx[3].uv = uv; vtx[3].col = col_trans;
+    }
+}
+
+// SIMD version of the anti-aliased stroke in ImDrawList::_PrimPolyline(), producing the exact same vertices and indices.
+// Segment normals and averaged point normals are computed for two segments/points per iteration, and the vertices
+// are written directly without going through a temporary buffer of positions.
+static void PolylineAntiAliasedSIMD(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
+{
+    const float AA_SIZE = 1.0f;
+    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+    const ImVec2 opaque_uv = draw_list->_Data->TexUvWhitePixel;
+    const int count = closed ? points_count : points_count-1;
+    const bool thick_line = (thickness > 1.0f);
+    const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+    const int vtx_stride = thick_line ? 4 : 3;
+    const int vtx_count = points_count * vtx_stride;
+    const ImFloat4 v_zero_5 = ImFloat4Set1(0.5f);
+    const ImFloat4 v_one = ImFloat4Set1(1.0f);
+    ImDrawVert opaque_vtx;
+    opaque_vtx.uv = opaque_uv;  // Encoded once: copied as is into every vertex (matters with IMGUI_USE_COMPACT_DRAWVERT)
+
+    // Segment normals: (dy, -dx) of normalized segment direction
+    ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
+    int i1 = 0;
+    {
+        const ImFloat4 v_flip_y = ImFloat4Set(1.0f, -1.0f, 1.0f, -1.0f);
+        for (; i1 + 2 < count; i1 += 2) // Leave the last segment to the scalar loop below
+        {
+            ImFloat4 d = ImFloat4Sub(ImFloat4Load(&points[i1 + 1].x), ImFloat4Load(&points[i1].x));
+            ImFloat4 d_sq = ImFloat4Mul(d, d);
+            ImFloat4 d2 = ImFloat4Add(d_sq, ImFloat4SwapPairs(d_sq));
+            ImFloat4 inv_len = ImFloat4Div(v_one, ImFloat4Sqrt(d2));
+            d = ImFloat4SelectGreaterThanZero(d2, ImFloat4Mul(d, inv_len), d);
+            ImFloat4Store(&temp_normals[i1].x, ImFloat4Mul(ImFloat4SwapPairs(d), v_flip_y));
+        }
+    }
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1+1) == points_count ? 0 : i1+1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        temp_normals[i1].x = dy;
+        temp_normals[i1].y = -dx;
+        if (!closed && i1 == count-1)
+        {
+            temp_normals[i1+1].x = dy;
+            temp_normals[i1+1].y = -dx;
+        }
+    }
+
+    // Indices
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    const unsigned int vtx_base_idx = draw_list->_VtxCurrentIdx;
+    unsigned int idx1 = vtx_base_idx;
+    for (i1 = 0; i1 < count; i1++)
+    {
+        const unsigned int idx2 = (i1+1) == points_count ? vtx_base_idx : idx1 + vtx_stride;
+        if (!thick_line)
+        {
+            idx_write[0] = (ImDrawIdx)(idx2+0); idx_write[1] = (ImDrawIdx)(idx1+0); idx_write[2] = (ImDrawIdx)(idx1+2);
+            idx_write[3] = (ImDrawIdx)(idx1+2); idx_write[4] = (ImDrawIdx)(idx2+2); idx_write[5] = (ImDrawIdx)(idx2+0);
+            idx_write[6] = (ImDrawIdx)(idx2+1); idx_write[7] = (ImDrawIdx)(idx1+1); idx_write[8] = (ImDrawIdx)(idx1+0);
+            idx_write[9] = (ImDrawIdx)(idx1+0); idx_write[10]= (ImDrawIdx)(idx2+0); idx_write[11]= (ImDrawIdx)(idx2+1);
+            idx_write += 12;
+        }
+        else
+        {
+            idx_write[0]  = (ImDrawIdx)(idx2 + 1); idx_write[1]  = (ImDrawIdx)(idx1 + 1); idx_write[2]  = (ImDrawIdx)(idx1 + 2);
+            idx_write[3]  = (ImDrawIdx)(idx1 + 2); idx_write[4]  = (ImDrawIdx)(idx2 + 2); idx_write[5]  = (ImDrawIdx)(idx2 + 1);
+            idx_write[6]  = (ImDrawIdx)(idx2 + 1); idx_write[7]  = (ImDrawIdx)(idx1 + 1); idx_write[8]  = (ImDrawIdx)(idx1 + 0);
+            idx_write[9]  = (ImDrawIdx)(idx1 + 0); idx_write[10] = (ImDrawIdx)(idx2 + 0); idx_write[11] = (ImDrawIdx)(idx2 + 1);
+            idx_write[12] = (ImDrawIdx)(idx2 + 2); idx_write[13] = (ImDrawIdx)(idx1 + 2); idx_write[14] = (ImDrawIdx)(idx1 + 3);
+            idx_write[15] = (ImDrawIdx)(idx1 + 3); idx_write[16] = (ImDrawIdx)(idx2 + 3); idx_write[17] = (ImDrawIdx)(idx2 + 2);
+            idx_write += 18;
+        }
+        idx1 = idx2;
+    }
+
+    // Vertices. The first point of an open line uses its segment normal, every other point uses the average of its two segment normals.
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    if (closed)
+    {
+        float dm_x = (temp_normals[points_count-1].x + temp_normals[0].x) * 0.5f;
+        float dm_y = (temp_normals[points_count-1].y + temp_normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        PolylineWritePointVertices(vtx_write, points[0], dm_x, dm_y, thick_line, half_inner_thickness, opaque_uv, col, col_trans);
+    }
+    else
+    {
+        PolylineWritePointVertices(vtx_write, points[0], temp_normals[0].x, temp_normals[0].y, thick_line, half_inner_thickness, opaque_uv, col, col_trans);
+    }
+    int i = 1;
+    const ImFloat4 v_thickness_out = ImFloat4Set1(half_inner_thickness + AA_SIZE);
+    const ImFloat4 v_thickness_in = ImFloat4Set1(half_inner_thickness);
+    for (; i + 1 < points_count; i += 2)
+    {
+        ImFloat4 dm = ImFloat4Mul(ImFloat4Add(ImFloat4Load(&temp_normals[i - 1].x), ImFloat4Load(&temp_normals[i].x)), v_zero_5);
+        ImFloat4 dm_sq = ImFloat4Mul(dm, dm);
+        ImFloat4 d2 = ImFloat4Max(v_zero_5, ImFloat4Add(dm_sq, ImFloat4SwapPairs(dm_sq)));    // Same as IM_FIXNORMAL2F(): if (d2 < 0.5f) d2 = 0.5f;
+        dm = ImFloat4Mul(dm, ImFloat4Div(v_one, d2));
+        const ImFloat4 p = ImFloat4Load(&points[i].x);
+        ImDrawVert* vtx = vtx_write + i * vtx_stride;
+        if (!thick_line)
+        {
+            // (AA_SIZE == 1.0f so we can skip scaling)
+            const ImFloat4 p_out0 = ImFloat4Add(p, dm);
+            const ImFloat4 p_out1 = ImFloat4Sub(p, dm);
+            ImFloat4StorePos(&vtx[0], &vtx[3], p);
+            ImFloat4StorePos(&vtx[1], &vtx[4], p_out0);
+            ImFloat4StorePos(&vtx[2], &vtx[5], p_out1);
+            for (int n = 0; n < 6; n++)
+                vtx[n].uv = opaque_vtx.uv;
+            vtx[0].col = col; vtx[1].col = col_trans; vtx[2].col = col_trans;
+            vtx[3].col = col; vtx[4].col = col_trans; vtx[5].col = col_trans;
+        }
+        else
+        {
+            const ImFloat4 dm_out = ImFloat4Mul(dm, v_thickness_out);
+            const ImFloat4 dm_in = ImFloat4Mul(dm, v_thickness_in);
+            const ImFloat4 p_out0 = ImFloat4Add(p, dm_out);
+            const ImFloat4 p_out1 = ImFloat4Add(p, dm_in);
+            const ImFloat4 p_out2 = ImFloat4Sub(p, dm_in);
+            const ImFloat4 p_out3 = ImFloat4Sub(p, dm_out);
+            ImFloat4StorePos(&vtx[0], &vtx[4], p_out0);
+            ImFloat4StorePos(&vtx[1], &vtx[5], p_out1);
+            ImFloat4StorePos(&vtx[2], &vtx[6], p_out2);
+            ImFloat4StorePos(&vtx[3], &vtx[7], p_out3);
+            for (int n = 0; n < 8; n++)
+                vtx[n].uv = opaque_vtx.uv;
+            vtx[0].col = col_trans; vtx[1].col = col; vtx[2].col = col; vtx[3].col = col_trans;
+            vtx[4].col = col_trans; vtx[5].col = col; vtx[6].col = col; vtx[7].col = col_trans;
+        }
+    }
+    for (; i < points_count; i++)
+    {
+        float dm_x = (temp_normals[i - 1].x + temp_normals[i].x) * 0.5f;
+        float dm_y = (temp_normals[i - 1].y + temp_normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        PolylineWritePointVertices(vtx_write + i * vtx_stride, points[i], dm_x, dm_y, thick_line, half_inner_thickness, opaque_uv, col, col_trans);
+    }
+
+    draw_list->_VtxWritePtr = vtx_write + vtx_count;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)vtx_count;
+}
+
+#endif // #if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+
+// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
+// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+void ImDrawList::_PrimPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness, bool anti_aliased)
+{
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+    if (anti_aliased)
+    {
+        PolylineAntiAliasedSIMD(this, points, points_count, col, closed, thickness);
+        return;
+    }
+#endif
+
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
     int count = points_count;
     if (!closed)
         count = points_count-1;
 
     const bool thick_line = (thickness > 1.0f);
-    if (Flags & ImDrawListFlags_AntiAliasedLines)
+    if (anti_aliased)
     {
         // Anti-aliased stroke
         const float AA_SIZE = 1.0f;
         const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-
-        const int idx_count = thick_line ? count*18 : count*12;
         const int vtx_count = thick_line ? points_count*4 : points_count*3;
-        PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
         ImVec2* temp_normals = (ImVec2*)alloca(points_count * (thick_line ? 5 : 3) * sizeof(ImVec2)); //-V630
@@ -779,10 +1214,6 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     else
     {
         // Non Anti-aliased Stroke
-        const int idx_count = count*6;
-        const int vtx_count = count*4;      // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
-
         for (int i1 = 0; i1 < count; i1++)
         {
             const int i2 = (i1+1) == points_count ? 0 : i1+1;
@@ -795,10 +1226,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             dx *= (thickness * 0.5f);
             dy *= (thickness * 0.5f);
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
@@ -809,22 +1240,37 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     }
 }
 
-// We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
 {
     if (points_count < 3)
         return;
 
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int idx_count = anti_aliased ? (points_count-2)*3 + points_count*6 : (points_count-2)*3;
+    const int vtx_count = anti_aliased ? (points_count*2) : points_count;
+    PrimReserve(idx_count, vtx_count);
+
+    if (Flags & ImDrawListFlags_DeferTessellation)
+    {
+        ImDrawListDeferredCmd* cmd = DeferPrimitiveWithPoints(this, ImDrawListDeferredCmdType_ConvexPolyFilled, idx_count, vtx_count, points, points_count);
+        cmd->Col = col;
+        cmd->AntiAliased = anti_aliased;
+        return;
+    }
+    _PrimConvexPolyFilled(points, points_count, col, anti_aliased);
+}
+
+// We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
+void ImDrawList::_PrimConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col, bool anti_aliased)
+{
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
-    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    if (anti_aliased)
     {
         // Anti-aliased Fill
         const float AA_SIZE = 1.0f;
         const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-        const int idx_count = (points_count-2)*3 + points_count*6;
         const int vtx_count = (points_count*2);
-        PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
@@ -860,8 +1306,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = ImVec2(points[i1].x - dm_x, points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = ImVec2(points[i1].x + dm_x, points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -874,9 +1320,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     else
     {
         // Non Anti-aliased Fill
-        const int idx_count = (points_count-2)*3;
         const int vtx_count = points_count;
-        PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
@@ -891,8 +1335,58 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
+// Generate vertices/indices of primitives recorded with ImDrawListFlags_DeferTessellation, into the space they have reserved.
+// Only this draw list is written to, so different draw lists may be processed concurrently (see io.ParallelForFn).
+void ImDrawList::_FlushDeferred()
+{
+    if (_Deferred == NULL || _Deferred->Cmds.Size == 0)
+        return;
+
+    ImDrawVert* vtx_write_backup = _VtxWritePtr;
+    ImDrawIdx* idx_write_backup = _IdxWritePtr;
+    unsigned int vtx_current_idx_backup = _VtxCurrentIdx;
+    for (int cmd_n = 0; cmd_n < _Deferred->Cmds.Size; cmd_n++)
+    {
+        const ImDrawListDeferredCmd& cmd = _Deferred->Cmds[cmd_n];
+        _VtxWritePtr = VtxBuffer.Data + cmd.VtxOffset;
+        _IdxWritePtr = IdxBuffer.Data + cmd.IdxOffset;
+        _VtxCurrentIdx = cmd.VtxCurrentIdx;
+        switch (cmd.Type)
+        {
+        case ImDrawListDeferredCmdType_Polyline:
+            _PrimPolyline(_Deferred->Points.Data + cmd.DataOffset, cmd.DataSize, cmd.Col, cmd.Closed, cmd.Size, cmd.AntiAliased);
+            break;
+        case ImDrawListDeferredCmdType_ConvexPolyFilled:
+            _PrimConvexPolyFilled(_Deferred->Points.Data + cmd.DataOffset, cmd.DataSize, cmd.Col, cmd.AntiAliased);
+            break;
+        case ImDrawListDeferredCmdType_Text:
+        {
+            const char* text = _Deferred->Text.Data + cmd.DataOffset;
+            RenderTextGlyphs(cmd.Font, this, cmd.Size, cmd.Pos, cmd.PosY, cmd.Col, cmd.ClipRect, text, text + cmd.DataSize, cmd.WrapWidth, cmd.CpuFineClip);
+
+            // Turn unused reserved space (clipped glyphs, blanks) into degenerate triangles
+            ImDrawVert* vtx_end = VtxBuffer.Data + cmd.VtxOffset + cmd.VtxCount;
+            ImDrawIdx* idx_end = IdxBuffer.Data + cmd.IdxOffset + cmd.IdxCount;
+            if (_VtxWritePtr < vtx_end)
+                memset(_VtxWritePtr, 0, (size_t)(vtx_end - _VtxWritePtr) * sizeof(ImDrawVert));
+            for (ImDrawIdx* idx_write = _IdxWritePtr; idx_write < idx_end; idx_write++)
+                *idx_write = (ImDrawIdx)cmd.VtxCurrentIdx;
+            _VtxWritePtr = vtx_end;
+            _IdxWritePtr = idx_end;
+            break;
+        }
+        }
+        IM_ASSERT(_VtxWritePtr == VtxBuffer.Data + cmd.VtxOffset + cmd.VtxCount && _IdxWritePtr == IdxBuffer.Data + cmd.IdxOffset + cmd.IdxCount);
+    }
+    _VtxWritePtr = vtx_write_backup;
+    _IdxWritePtr = idx_write_backup;
+    _VtxCurrentIdx = vtx_current_idx_backup;
+    _Deferred->Clear();
+}
+
 void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     if (radius == 0.0f || a_min_of_12 > a_max_of_12)
     {
         _Path.push_back(center);
@@ -916,6 +1410,7 @@ void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_
 
 void ImDrawList::PathArcTo(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     if (radius == 0.0f)
     {
         _Path.push_back(center);
@@ -970,6 +1465,7 @@ static void PathBezierToCasteljau(ImVector<ImVec2>* path, float x1, float y1, fl
 
 void ImDrawList::PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     ImVec2 p1 = _Path.back();
     if (num_segments == 0)
     {
@@ -1039,7 +1535,7 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
         PathRect(p_min, p_max, rounding, rounding_corners);
         PathFillConvex(col);
     }
-    else
+    else if (!(Flags & ImDrawListFlags_CpuClipRect) || !_PrimRectCpuClipped(p_min, p_max, _Data->TexUvWhitePixel, _Data->TexUvWhitePixel, col))
     {
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
@@ -1203,6 +1699,154 @@ void ImDrawList::AddBezierCurve(const ImVec2& p1, const ImVec2& p2, const ImVec2
     PathStroke(col, false, thickness);
 }
 
+// Helper for AddPolylineStrided(): gather visible runs of the polyline in draw_list->_Path and stroke each run once it is interrupted.
+// We append after any path under construction so the caller's _Path is preserved.
+struct ImDrawListStridedPolyline
+{
+    enum { MaxPointsPerStroke = 4096 };     // Keep each AddPolyline() call well under 64K vertices, to stay friendly with 16-bit indices
+
+    ImDrawList* DrawList;
+    ImVec4      CullRect;
+    ImU32       Col;
+    float       Thickness;
+    int         PathStart;
+    ImVec2      PrevPos;
+    bool        HasPrev;
+
+    ImDrawListStridedPolyline(ImDrawList* draw_list, const ImVec4& cull_rect, ImU32 col, float thickness) { DrawList = draw_list; CullRect = cull_rect; Col = col; Thickness = thickness; PathStart = draw_list->_Path.Size; HasPrev = false; }
+
+    void Stroke()
+    {
+        ImVector<ImVec2>& path = DrawList->_Path;
+        if (path.Size - PathStart >= 2)
+            DrawList->AddPolyline(path.Data + PathStart, path.Size - PathStart, Col, false, Thickness);
+        path.Size = PathStart;
+    }
+
+    void Break()
+    {
+        Stroke();
+        HasPrev = false;
+    }
+
+    void AddPoint(const ImVec2& p)
+    {
+        if (HasPrev)
+        {
+            // Cull segments lying entirely on one side of the clipping rectangle
+            const ImVec2& p0 = PrevPos;
+            const ImVec4& cr = CullRect;
+            if ((p0.x < cr.x && p.x < cr.x) || (p0.x > cr.z && p.x > cr.z) || (p0.y < cr.y && p.y < cr.y) || (p0.y > cr.w && p.y > cr.w))
+            {
+                Stroke();
+            }
+            else
+            {
+                ImVector<ImVec2>& path = DrawList->_Path;
+                if (path.Size == PathStart)
+                    path.push_back(p0);
+                path.push_back(p);
+                if (path.Size - PathStart >= MaxPointsPerStroke)
+                    Stroke();
+            }
+        }
+        PrevPos = p;
+        HasPrev = true;
+    }
+};
+
+// Decimation: all consecutive samples falling in the same pixel column are reduced to the first, min, max and last ones (in that order of appearance).
+// This preserves the envelope of the signal and the connections between columns, while producing at most 4 points per column.
+void ImDrawList::AddPolylineStrided(const float* xs, const float* ys, int count, int stride, const ImVec2& offset, const ImVec2& scale, ImU32 col, float thickness)
+{
+    IM_ASSERT(ys != NULL && stride > 0);
+    if ((col & IM_COL32_A_MASK) == 0 || count < 2)
+        return;
+
+    // Expand the clipping rectangle by the line thickness (+ anti-aliasing fringe) so culled segments cannot have visible pixels.
+    const ImVec4 clip_rect = _ClipRectStack.Size ? _ClipRectStack.back() : _Data->ClipRectFullscreen;
+    const float cull_pad = thickness + 1.0f;
+    const ImVec4 cull_rect(clip_rect.x - cull_pad, clip_rect.y - cull_pad, clip_rect.z + cull_pad, clip_rect.w + cull_pad);
+
+    // With implicit x coordinates we can skip invisible samples without reading them (keeping one extra sample on each side).
+    int n_begin = 0;
+    int n_end = count;
+    if (xs == NULL && scale.x != 0.0f)
+    {
+        float visible_min = (cull_rect.x - offset.x) / scale.x;
+        float visible_max = (cull_rect.z - offset.x) / scale.x;
+        if (visible_min > visible_max)
+            ImSwap(visible_min, visible_max);
+        if (visible_max < 0.0f || visible_min >= (float)count)
+            return;
+        n_begin = ImMax(0, (int)ImFloorStd(ImMax(visible_min, 0.0f)) - 1);
+        n_end = ImMin(count, (int)ImFloorStd(ImMin(visible_max, (float)count)) + 2);
+    }
+
+    ImDrawListStridedPolyline builder(this, cull_rect, col, thickness);
+
+    // Current pixel column
+    bool column_active = false;
+    float column_x = 0.0f;
+    ImVec2 p_first, p_min, p_max, p_last;
+    int n_first = 0, n_min = 0, n_max = 0, n_last = 0;
+
+    const char* xs_ptr = (const char*)xs;
+    const char* ys_ptr = (const char*)ys;
+    for (int n = n_begin; n <= n_end; n++)
+    {
+        ImVec2 p;
+        bool valid = false;
+        if (n < n_end)
+        {
+            const float x = xs_ptr ? *(const float*)(const void*)(xs_ptr + (size_t)n * stride) : (float)n;
+            const float y = *(const float*)(const void*)(ys_ptr + (size_t)n * stride);
+            p = ImVec2(offset.x + x * scale.x, offset.y + y * scale.y);
+            valid = (p.x == p.x && p.y == p.y); // NaN values leave a gap
+        }
+
+        // Same column: extend it
+        if (valid && column_active && ImFloorStd(p.x) == column_x)
+        {
+            if (p.y < p_min.y) { p_min = p; n_min = n; }
+            if (p.y > p_max.y) { p_max = p; n_max = n; }
+            p_last = p;
+            n_last = n;
+            continue;
+        }
+
+        // Emit previous column
+        if (column_active)
+        {
+            const bool min_first = (n_min < n_max);
+            const ImVec2& p_lo = min_first ? p_min : p_max;
+            const ImVec2& p_hi = min_first ? p_max : p_min;
+            const int n_lo = min_first ? n_min : n_max;
+            const int n_hi = min_first ? n_max : n_min;
+            builder.AddPoint(p_first);
+            if (n_lo != n_first && n_lo != n_last)
+                builder.AddPoint(p_lo);
+            if (n_hi != n_first && n_hi != n_last && n_hi != n_lo)
+                builder.AddPoint(p_hi);
+            if (n_last != n_first)
+                builder.AddPoint(p_last);
+        }
+        if (!valid)
+        {
+            builder.Break();
+            column_active = false;
+            continue;
+        }
+
+        // Start new column
+        column_active = true;
+        column_x = ImFloorStd(p.x);
+        p_first = p_min = p_max = p_last = p;
+        n_first = n_min = n_max = n_last = n;
+    }
+    builder.Stroke();
+}
+
 void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -1229,6 +1873,15 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
         clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect->z);
         clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
     }
+
+    // With ImDrawListFlags_CpuClipRect, when the current command uses a larger clip rectangle, clip glyphs on the CPU and keep using the command
+    if ((Flags & ImDrawListFlags_CpuClipRect) && memcmp(&CmdBuffer.back().ClipRect, &_ClipRectStack.back(), sizeof(ImVec4)) != 0)
+    {
+        Flags &= ~ImDrawListFlags_CpuClipRect; // Don't let PrimReserve() add a command
+        font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, true);
+        Flags |= ImDrawListFlags_CpuClipRect;
+        return;
+    }
     font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip_rect != NULL);
 }
 
@@ -1246,8 +1899,11 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
     if (push_texture_id)
         PushTextureID(user_texture_id);
 
-    PrimReserve(6, 4);
-    PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    if (!(Flags & ImDrawListFlags_CpuClipRect) || !_PrimRectCpuClipped(p_min, p_max, uv_min, uv_max, col))
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(p_min, p_max, uv_min, uv_max, col);
+    }
 
     if (push_texture_id)
         PopTextureID();
@@ -1317,6 +1973,7 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -1355,6 +2012,7 @@ static inline bool CanMergeDrawCommands(ImDrawCmd* a, ImDrawCmd* b)
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
+    IMGUI_ALLOC_SCOPE("ImDrawList");
     // Note that we never use or rely on channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
         return;
@@ -1413,6 +2071,7 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     IM_ASSERT(idx >= 0 && idx < _Count);
     if (_Current == idx)
         return;
+    draw_list->_FlushDeferred(); // Deferred primitives refer to the current channel IdxBuffer
     // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
@@ -1441,8 +2100,15 @@ void ImDrawData::DeIndexAllBuffers()
             new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
         cmd_list->VtxBuffer.swap(new_vtx_buffer);
         cmd_list->IdxBuffer.resize(0);
+        cmd_list->_ModifiedAfterRender = true;
         TotalVtxCount += cmd_list->VtxBuffer.Size;
     }
+
+    // The arena still holds the indexed copy of the buffers: drop it
+    ArenaVtxBuffer = NULL;
+    ArenaIdxBuffer = NULL;
+    ArenaCmdBuffer = NULL;
+    ArenaCmdCount = 0;
 }
 
 // Helper to scale the ClipRect field of each ImDrawCmd.
@@ -1458,6 +2124,12 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
             ImDrawCmd* cmd = &cmd_list->CmdBuffer[cmd_i];
             cmd->ClipRect = ImVec4(cmd->ClipRect.x * fb_scale.x, cmd->ClipRect.y * fb_scale.y, cmd->ClipRect.z * fb_scale.x, cmd->ClipRect.w * fb_scale.y);
         }
+        cmd_list->_ModifiedAfterRender = true;
+    }
+    for (int cmd_i = 0; cmd_i < ArenaCmdCount; cmd_i++)
+    {
+        ImDrawCmd* cmd = &ArenaCmdBuffer[cmd_i];
+        cmd->ClipRect = ImVec4(cmd->ClipRect.x * fb_scale.x, cmd->ClipRect.y * fb_scale.y, cmd->ClipRect.z * fb_scale.x, cmd->ClipRect.w * fb_scale.y);
     }
 }
 
@@ -1468,13 +2140,14 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    draw_list->_FlushDeferred(); // Generate vertices before we modify them (with ImDrawListFlags_DeferTessellation)
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
     for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
     {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float d = ImDot(ImVec2(vert->pos) - gradient_p0, gradient_extent);
         float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         int r = ImLerp((int)(col0 >> IM_COL32_R_SHIFT) & 0xFF, (int)(col1 >> IM_COL32_R_SHIFT) & 0xFF, t);
         int g = ImLerp((int)(col0 >> IM_COL32_G_SHIFT) & 0xFF, (int)(col1 >> IM_COL32_G_SHIFT) & 0xFF, t);
@@ -1486,6 +2159,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    draw_list->_FlushDeferred(); // Generate vertices before we modify them (with ImDrawListFlags_DeferTessellation)
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -1499,12 +2173,12 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
         const ImVec2 min = ImMin(uv_a, uv_b);
         const ImVec2 max = ImMax(uv_a, uv_b);
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos) - a, scale), min, max);
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos) - a, scale);
     }
 }
 
@@ -1600,6 +2274,7 @@ ImFontAtlas::ImFontAtlas()
     TexWidth = TexHeight = 0;
     TexUvScale = ImVec2(0.0f, 0.0f);
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+    BuildCount = 0;
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
 }
@@ -1701,6 +2376,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    IMGUI_ALLOC_SCOPE("ImFontAtlas");
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
@@ -1827,6 +2503,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
 
 int ImFontAtlas::AddCustomRectRegular(int width, int height)
 {
+    IMGUI_ALLOC_SCOPE("ImFontAtlas");
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
     ImFontAtlasCustomRect r;
@@ -1838,6 +2515,7 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    IMGUI_ALLOC_SCOPE("ImFontAtlas");
 #ifdef IMGUI_USE_WCHAR32
     IM_ASSERT(id <= IM_UNICODE_CODEPOINT_MAX);
 #endif
@@ -1886,6 +2564,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IMGUI_ALLOC_SCOPE("ImFontAtlas");
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     return ImFontAtlasBuildWithStbTruetype(this);
 }
@@ -2304,6 +2983,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
     for (int i = 0; i < atlas->Fonts.Size; i++)
         if (atlas->Fonts[i]->DirtyLookupTables)
             atlas->Fonts[i]->BuildLookupTable();
+    atlas->BuildCount++;
 
     // Ellipsis character is required for rendering elided text. We prefer using U+2026 (horizontal ellipsis).
     // However some old fonts may contain ellipsis at U+0085. Here we auto-detect most suitable ellipsis character.
@@ -2766,6 +3446,55 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     return &Glyphs.Data[i];
 }
 
+// Return the end of the run of printable ASCII characters (0x20..0x7F) starting at 's', which don't need UTF-8 decoding nor special handling.
+// With SSE2/NEON we test 16 bytes at a time: bytes >= 0x80 are negative as signed bytes, so a single signed comparison with 0x20 detects both
+// control characters (e.g. '\n') and UTF-8 sequences.
+static inline const char* ImTextFindPrintableAsciiEnd(const char* s, const char* s_end)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_space = _mm_set1_epi8(0x20);
+    for (; s_end - s >= 16; s += 16)
+        if (_mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(const void*)s), v_space)) != 0)
+            break;
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t v_space = vdupq_n_s8(0x20);
+    for (; s_end - s >= 16; s += 16)
+        if (vmaxvq_u8(vcltq_s8(vld1q_s8((const int8_t*)s), v_space)) != 0)
+            break;
+#endif
+    while (s < s_end && (signed char)*s >= 0x20)
+        s++;
+    return s;
+}
+
+// Count characters in [s, s_end) which are not '\n', '\r', or ' ' if 'count_spaces' is false. This is an upper bound of the number of glyphs rendered.
+static int ImTextCountRenderedCharsUpperBound(const char* s, const char* s_end, bool count_spaces)
+{
+    int count = 0;
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128i v_lf = _mm_set1_epi8('\n'), v_cr = _mm_set1_epi8('\r'), v_space = _mm_set1_epi8(count_spaces ? '\n' : ' '), v_one = _mm_set1_epi8(1);
+    for (; s_end - s >= 16; s += 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)s);
+        const __m128i skipped = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, v_lf), _mm_cmpeq_epi8(v, v_cr)), _mm_cmpeq_epi8(v, v_space));
+        const __m128i sums = _mm_sad_epu8(_mm_and_si128(skipped, v_one), _mm_setzero_si128()); // Two 16-bit sums of 8 bytes each
+        count += 16 - (_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4));
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    const uint8x16_t v_lf = vdupq_n_u8('\n'), v_cr = vdupq_n_u8('\r'), v_space = vdupq_n_u8(count_spaces ? '\n' : ' '), v_one = vdupq_n_u8(1);
+    for (; s_end - s >= 16; s += 16)
+    {
+        const uint8x16_t v = vld1q_u8((const uint8_t*)s);
+        const uint8x16_t skipped = vorrq_u8(vorrq_u8(vceqq_u8(v, v_lf), vceqq_u8(v, v_cr)), vceqq_u8(v, v_space));
+        count += 16 - (int)vaddvq_u8(vandq_u8(skipped, v_one));
+    }
+#endif
+    for (; s < s_end; s++)
+        if (*s != '\n' && *s != '\r' && (*s != ' ' || count_spaces))
+            count++;
+    return count;
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -2879,9 +3608,33 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Fast path for runs of printable ASCII characters, when we don't need to stop at a given width.
+    // Advances are accumulated in 4 independent sums to avoid waiting on the latency of each addition, so the result may differ
+    // by float rounding from the one of the per-character loop below.
+    const bool ascii_fast_path = !word_wrap_enabled && max_width == FLT_MAX && IndexAdvanceX.Size >= 0x80;
+
     const char* s = text_begin;
     while (s < text_end)
     {
+        if (ascii_fast_path && (signed char)*s >= 0x20)
+        {
+            const char* run_end = ImTextFindPrintableAsciiEnd(s, text_end);
+            const float* advance_x = IndexAdvanceX.Data;
+            float w0 = 0.0f, w1 = 0.0f, w2 = 0.0f, w3 = 0.0f;
+            for (; run_end - s >= 4; s += 4)
+            {
+                w0 += advance_x[(unsigned char)s[0]];
+                w1 += advance_x[(unsigned char)s[1]];
+                w2 += advance_x[(unsigned char)s[2]];
+                w3 += advance_x[(unsigned char)s[3]];
+            }
+            for (; s < run_end; s++)
+                w0 += advance_x[(unsigned char)*s];
+            line_width += ((w0 + w1) + (w2 + w3)) * scale;
+            if (s == text_end)
+                break;
+        }
+
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
@@ -2979,15 +3732,19 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     // Align to be pixel perfect
     pos.x = IM_FLOOR(pos.x + DisplayOffset.x);
     pos.y = IM_FLOOR(pos.y + DisplayOffset.y);
-    float x = pos.x;
     float y = pos.y;
     if (y > clip_rect.w)
         return;
 
+    // Translate the cached layout of the text when available (only done when fully visible, so output is the same)
+    if (ImFontTextCache* text_cache = draw_list->_Data->TextCache)
+        if (ImFontTextCacheEntry* entry = text_cache->GetEntry(this, size, wrap_width, text_begin, text_end))
+            if (RenderTextCached(this, draw_list, text_cache, entry, pos, col, clip_rect, text_begin, text_end))
+                return;
+
     const float scale = size / FontSize;
     const float line_height = FontSize * scale;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
-    const char* word_wrap_eol = NULL;
 
     // Fast-forward to first visible line
     const char* s = text_begin;
@@ -3001,7 +3758,9 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
     // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
-    if (text_end - s > 10000 && !word_wrap_enabled)
+    // With deferred tessellation the reservation can't be trimmed afterwards, so we always scan.
+    const bool defer_tessellation = (draw_list->Flags & ImDrawListFlags_DeferTessellation) != 0;
+    if ((text_end - s > 10000 || defer_tessellation) && !word_wrap_enabled)
     {
         const char* s_end = s;
         float y_end = y;
@@ -3016,11 +3775,55 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     if (s == text_end)
         return;
 
+    if (defer_tessellation)
+    {
+        // Reserve vertices for characters which may output a glyph, and record the text to render it later in ImDrawList::_FlushDeferred().
+        // Unlike the regular path we can't give back unused vertices once other primitives have been added after ours, so we don't reserve for blanks.
+        const ImFontGlyph* space_glyph = FindGlyph((ImWchar)' ');
+        const bool space_visible = space_glyph && space_glyph->Visible;
+        const int char_count = ImTextCountRenderedCharsUpperBound(s, text_end, space_visible);
+        if (char_count == 0)
+            return;
+        draw_list->PrimReserve(char_count * 6, char_count * 4);
+        ImDrawListDeferredCmd* cmd = DeferPrimitive(draw_list, ImDrawListDeferredCmdType_Text, char_count * 6, char_count * 4);
+        cmd->Col = col;
+        cmd->Size = size;
+        cmd->CpuFineClip = cpu_fine_clip;
+        cmd->Font = this;
+        cmd->Pos = pos;
+        cmd->PosY = y;
+        cmd->WrapWidth = wrap_width;
+        cmd->ClipRect = clip_rect;
+        ImVector<char>& deferred_text = draw_list->_Deferred->Text;
+        cmd->DataOffset = deferred_text.Size;
+        cmd->DataSize = (int)(text_end - s);
+        deferred_text.resize(deferred_text.Size + cmd->DataSize);
+        memcpy(deferred_text.Data + cmd->DataOffset, s, (size_t)cmd->DataSize);
+        return;
+    }
+
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
     const int vtx_count_max = (int)(text_end - s) * 4;
     const int idx_count_max = (int)(text_end - s) * 6;
     const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
     draw_list->PrimReserve(idx_count_max, vtx_count_max);
+    RenderTextGlyphs(this, draw_list, size, pos, y, col, clip_rect, s, text_end, wrap_width, cpu_fine_clip);
+
+    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
+    draw_list->VtxBuffer.Size = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data); // Same as calling shrink()
+    draw_list->IdxBuffer.Size = (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+}
+
+// Output glyphs for [s, text_end) into vertices/indices previously reserved with PrimReserve(), advancing the draw list write pointers.
+// 'pos' is the pixel aligned position of the first line (new lines restart at pos.x), 'y' the position of the line containing 's'.
+static void RenderTextGlyphs(const ImFont* font, ImDrawList* draw_list, float size, ImVec2 pos, float y, ImU32 col, const ImVec4& clip_rect, const char* s, const char* text_end, float wrap_width, bool cpu_fine_clip)
+{
+    const float scale = size / font->FontSize;
+    const float line_height = font->FontSize * scale;
+    const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const char* word_wrap_eol = NULL;
+    float x = pos.x;
 
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
@@ -3033,7 +3836,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
             {
-                word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
+                word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
             }
@@ -3081,7 +3884,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 continue;
         }
 
-        const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
+        const ImFontGlyph* glyph = font->FindGlyph((ImWchar)c);
         if (glyph == NULL)
             continue;
 
@@ -3135,10 +3938,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 {
                     idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                     idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = col; vtx_write[0].uv = ImVec2(u1, v1);
+                    vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = col; vtx_write[1].uv = ImVec2(u2, v1);
+                    vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = col; vtx_write[2].uv = ImVec2(u2, v2);
+                    vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = col; vtx_write[3].uv = ImVec2(u1, v2);
                     vtx_write += 4;
                     vtx_current_idx += 4;
                     idx_write += 6;
@@ -3148,15 +3951,245 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         x += char_width;
     }
 
-    // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
-    draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
-    draw_list->IdxBuffer.Size = (int)(idx_write - draw_list->IdxBuffer.Data);
-    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_current_idx;
 }
 
+// Output the glyph quads of a cached text layout, recording them first if needed. Return false if the text needs to be clipped, in which case the caller renders it.
+static bool RenderTextCached(const ImFont* font, ImDrawList* draw_list, ImFontTextCache* cache, ImFontTextCacheEntry* entry, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end)
+{
+    if (entry->QuadsOffset == -1)
+    {
+        // Output all glyphs without clipping, then read back vertices to record them.
+        const int vtx_count_max = (int)(text_end - text_begin) * 4;
+        const int idx_count_max = (int)(text_end - text_begin) * 6;
+        const int idx_expected_size = draw_list->IdxBuffer.Size + idx_count_max;
+        draw_list->PrimReserve(idx_count_max, vtx_count_max);
+        ImDrawVert* vtx_begin = draw_list->_VtxWritePtr;
+        ImDrawIdx* idx_begin = draw_list->_IdxWritePtr;
+        const unsigned int vtx_current_idx_begin = draw_list->_VtxCurrentIdx;
+        RenderTextGlyphs(font, draw_list, entry->Size, pos, pos.y, col, ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX), text_begin, text_end, entry->WrapWidth, false);
+
+        entry->QuadsOffset = cache->Quads.Size;
+        entry->QuadsCount = (int)(draw_list->_VtxWritePtr - vtx_begin) / 4;
+        entry->QuadsBounds = ImVec4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        cache->Quads.resize(cache->Quads.Size + entry->QuadsCount);
+        ImFontTextCacheQuad* quad = cache->Quads.Data + entry->QuadsOffset;
+        for (const ImDrawVert* vtx = vtx_begin; vtx < draw_list->_VtxWritePtr; vtx += 4, quad++)
+        {
+            quad->Min = ImVec2(vtx[0].pos) - pos;
+            quad->Max = ImVec2(vtx[2].pos) - pos;
+            quad->UvMin = vtx[0].uv;
+            quad->UvMax = vtx[2].uv;
+            entry->QuadsBounds = ImVec4(ImMin(entry->QuadsBounds.x, quad->Min.x), ImMin(entry->QuadsBounds.y, quad->Min.y), ImMax(entry->QuadsBounds.z, quad->Max.x), ImMax(entry->QuadsBounds.w, quad->Max.y));
+        }
+
+        // Discard our output if the text is not fully visible
+        const bool visible = (pos.x + entry->QuadsBounds.x >= clip_rect.x && pos.y + entry->QuadsBounds.y >= clip_rect.y && pos.x + entry->QuadsBounds.z <= clip_rect.z && pos.y + entry->QuadsBounds.w <= clip_rect.w);
+        if (!visible)
+        {
+            draw_list->_VtxWritePtr = vtx_begin;
+            draw_list->_IdxWritePtr = idx_begin;
+            draw_list->_VtxCurrentIdx = vtx_current_idx_begin;
+        }
+
+        // Give back unused vertices, same as ImFont::RenderText()
+        draw_list->VtxBuffer.Size = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data);
+        draw_list->IdxBuffer.Size = (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+        draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+        return visible;
+    }
+
+    if (pos.x + entry->QuadsBounds.x < clip_rect.x || pos.y + entry->QuadsBounds.y < clip_rect.y || pos.x + entry->QuadsBounds.z > clip_rect.z || pos.y + entry->QuadsBounds.w > clip_rect.w)
+        return false;
+    if (entry->QuadsCount == 0)
+        return true;
+
+    draw_list->PrimReserve(entry->QuadsCount * 6, entry->QuadsCount * 4);
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+    const ImFontTextCacheQuad* quad_end = cache->Quads.Data + entry->QuadsOffset + entry->QuadsCount;
+    for (const ImFontTextCacheQuad* quad = cache->Quads.Data + entry->QuadsOffset; quad < quad_end; quad++)
+    {
+        const float x1 = pos.x + quad->Min.x, y1 = pos.y + quad->Min.y, x2 = pos.x + quad->Max.x, y2 = pos.y + quad->Max.y;
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = col; vtx_write[0].uv = ImVec2(quad->UvMin.x, quad->UvMin.y);
+        vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = col; vtx_write[1].uv = ImVec2(quad->UvMax.x, quad->UvMin.y);
+        vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = col; vtx_write[2].uv = ImVec2(quad->UvMax.x, quad->UvMax.y);
+        vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = col; vtx_write[3].uv = ImVec2(quad->UvMin.x, quad->UvMax.y);
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = vtx_current_idx;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImFontTextCache
+//-----------------------------------------------------------------------------
+
+int ImFontTextCache::GetMemoryUsage() const
+{
+    return Entries.Size * (int)sizeof(ImFontTextCacheEntry) + Buckets.Size * (int)sizeof(int) + TextBuf.Size + Quads.Size * (int)sizeof(ImFontTextCacheQuad) + Seen.Size * (int)sizeof(ImU64);
+}
+
+void ImFontTextCache::RebuildBuckets(int buckets_count)
+{
+    IM_ASSERT(ImIsPowerOfTwo(buckets_count) && buckets_count >= Entries.Size * 2);
+    Buckets.resize(buckets_count);
+    memset(Buckets.Data, 0xFF, (size_t)Buckets.size_in_bytes());
+    const ImU32 mask = (ImU32)buckets_count - 1;
+    for (int n = 0; n < Entries.Size; n++)
+    {
+        ImU32 bucket = Entries[n].Hash & mask;
+        while (Buckets[bucket] != -1)
+            bucket = (bucket + 1) & mask;
+        Buckets[bucket] = n;
+    }
+}
+
+ImFontTextCacheEntry* ImFontTextCache::GetEntry(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end)
+{
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int text_length = (int)(text_end - text);
+    if (text_length < IMGUI_TEXT_CACHE_MIN_LENGTH || text_length > IMGUI_TEXT_CACHE_MAX_LENGTH)
+        return NULL;
+
+    struct { const ImFont* Font; float Size; float WrapWidth; } key;
+    memset(&key, 0, sizeof(key)); // Clear padding
+    key.Font = font;
+    key.Size = size;
+    key.WrapWidth = wrap_width;
+    const ImGuiID hash = ImHashData(text, (size_t)text_length, ImHashData(&key, sizeof(key)));
+
+    // Lookup
+    const int atlas_build_count = font->ContainerAtlas ? font->ContainerAtlas->BuildCount : 0;
+    ImU32 bucket = 0;
+    if (Buckets.Size > 0)
+    {
+        const ImU32 mask = (ImU32)Buckets.Size - 1;
+        for (bucket = hash & mask; Buckets[bucket] != -1; bucket = (bucket + 1) & mask)
+        {
+            ImFontTextCacheEntry* entry = &Entries[Buckets[bucket]];
+            if (entry->Hash != hash || entry->Font != font || entry->Size != size || entry->WrapWidth != wrap_width || entry->TextLength != text_length || memcmp(TextBuf.Data + entry->TextOffset, text, (size_t)text_length) != 0)
+                continue;
+            entry->LastUsedFrame = Frame;
+            if (entry->AtlasBuildCount == atlas_build_count)
+            {
+                HitCount++;
+                return entry;
+            }
+            // Glyphs have changed: recalculate layout (previous quads will be discarded by next GarbageCollect() rebuilding storage)
+            entry->AtlasBuildCount = atlas_build_count;
+            entry->TextSize = font->CalcTextSizeA(size, FLT_MAX, wrap_width, text, text_end, NULL);
+            entry->QuadsOffset = -1;
+            entry->QuadsCount = 0;
+            MissCount++;
+            return entry;
+        }
+    }
+
+    // Add if the text was already seen on a previous frame
+    MissCount++;
+    if (Seen.Size == 0)
+    {
+        Seen.resize(IMGUI_TEXT_CACHE_SEEN_COUNT);
+        memset(Seen.Data, 0xFF, (size_t)Seen.size_in_bytes());
+    }
+    ImU64& seen = Seen[hash & (IMGUI_TEXT_CACHE_SEEN_COUNT - 1)];
+    const bool seen_previous_frame = ((ImGuiID)seen == hash && (int)(seen >> 32) != Frame);
+    seen = ((ImU64)(ImU32)Frame << 32) | hash;
+    if (!seen_previous_frame)
+        return NULL;
+    Entries.resize(Entries.Size + 1);
+    ImFontTextCacheEntry* entry = &Entries.back();
+    entry->Hash = hash;
+    entry->Font = font;
+    entry->Size = size;
+    entry->WrapWidth = wrap_width;
+    entry->AtlasBuildCount = atlas_build_count;
+    entry->TextOffset = TextBuf.Size;
+    entry->TextLength = text_length;
+    entry->QuadsOffset = -1;
+    entry->QuadsCount = 0;
+    entry->QuadsBounds = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    entry->TextSize = font->CalcTextSizeA(size, FLT_MAX, wrap_width, text, text_end, NULL);
+    entry->LastUsedFrame = Frame;
+    TextBuf.resize(TextBuf.Size + text_length);
+    memcpy(TextBuf.Data + entry->TextOffset, text, (size_t)text_length);
+    if (Entries.Size * 2 > Buckets.Size)
+        RebuildBuckets(ImMax(Buckets.Size * 2, 256));
+    else
+        Buckets[bucket] = Entries.Size - 1;
+    return &Entries.back();
+}
+
+static int IMGUI_CDECL TextCacheEntryComparerByLastUsedFrame(const void* lhs, const void* rhs)
+{
+    // Most recently used first
+    return ((const ImFontTextCacheEntry*)rhs)->LastUsedFrame - ((const ImFontTextCacheEntry*)lhs)->LastUsedFrame;
+}
+
+// Called once per frame by NewFrame(). When over budget, keep most recently used entries up to 3/4 of the budget and rebuild contiguous storage.
+void ImFontTextCache::GarbageCollect(int memory_budget)
+{
+    Frame++;
+    if (GetMemoryUsage() <= memory_budget)
+        return;
+
+    ImVector<ImFontTextCacheEntry> old_entries;
+    ImVector<char> old_text_buf;
+    ImVector<ImFontTextCacheQuad> old_quads;
+    old_entries.swap(Entries);
+    old_text_buf.swap(TextBuf);
+    old_quads.swap(Quads);
+    ImQsort(old_entries.Data, (size_t)old_entries.Size, sizeof(ImFontTextCacheEntry), TextCacheEntryComparerByLastUsedFrame);
+
+    const int memory_target = memory_budget - memory_budget / 4;
+    int memory_usage = 0;
+    int keep_count = 0;
+    while (keep_count < old_entries.Size)
+    {
+        const ImFontTextCacheEntry& entry = old_entries[keep_count];
+        memory_usage += (int)(sizeof(ImFontTextCacheEntry) + sizeof(int) * 2) + entry.TextLength + entry.QuadsCount * (int)sizeof(ImFontTextCacheQuad);
+        if (memory_usage > memory_target)
+            break;
+        keep_count++;
+    }
+    EvictCount += old_entries.Size - keep_count;
+
+    Entries.reserve(keep_count);
+    for (int n = 0; n < keep_count; n++)
+    {
+        ImFontTextCacheEntry entry = old_entries[n];
+        const int text_offset = TextBuf.Size;
+        TextBuf.resize(TextBuf.Size + entry.TextLength);
+        memcpy(TextBuf.Data + text_offset, old_text_buf.Data + entry.TextOffset, (size_t)entry.TextLength);
+        entry.TextOffset = text_offset;
+        if (entry.QuadsOffset != -1)
+        {
+            const int quads_offset = Quads.Size;
+            Quads.resize(Quads.Size + entry.QuadsCount);
+            if (entry.QuadsCount > 0)
+                memcpy(Quads.Data + quads_offset, old_quads.Data + entry.QuadsOffset, (size_t)entry.QuadsCount * sizeof(ImFontTextCacheQuad));
+            entry.QuadsOffset = quads_offset;
+        }
+        Entries.push_back(entry);
+    }
+    int buckets_count = 256;
+    while (buckets_count < Entries.Size * 2)
+        buckets_count *= 2;
+    Buckets.clear();
+    RebuildBuckets(buckets_count);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGui Internal Render Helpers
 //-----------------------------------------------------------------------------
@@ -23,6 +23,7 @@ Index of this file:
 // [SECTION] Multi-select support
 // [SECTION] Docking support
 // [SECTION] Viewport support
+// [SECTION] Profiler support
 // [SECTION] ImGuiContext (main imgui context)
 // [SECTION] ImGuiWindowTempData, ImGuiWindow
 // [SECTION] Tab bar, Tab item support
@@ -48,6 +49,15 @@ Index of this file:
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// Enable SSE2/NEON intrinsics if available (used by some ImDrawList tessellation kernels, which also have a scalar fallback)
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SIMD)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>
+#elif (defined __aarch64__ || defined _M_ARM64) && !defined(IMGUI_DISABLE_SIMD)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -86,9 +96,14 @@ Index of this file:
 
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
+struct ImRectGrid;                  // Uniform grid to find the front-most rectangle containing a point
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImFontTextCache;             // Cache of text layouts (size and glyph quads), used by CalcTextSize() and ImFont::RenderText()
+struct ImFrameArena;                // Bump allocator for temporary memory, reset by NewFrame()
+struct ImGuiAllocSite;              // Number and size of allocations made by one call site (when IMGUI_ENABLE_ALLOC_TRACKING is defined)
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
+struct ImGuiColorPickerMesh;        // Cached hue wheel mesh of ColorPicker4() (see RenderColorPickerHueWheel())
 struct ImGuiColumnData;             // Storage data for a single column
 struct ImGuiColumns;                // Storage data for a columns set
 struct ImGuiContext;                // Main Dear ImGui context
@@ -100,13 +115,16 @@ struct ImGuiMenuColumns;            // Simple column measurement, currently used
 struct ImGuiNavMoveResult;          // Result of a gamepad/keyboard directional navigation move query result
 struct ImGuiNextWindowData;         // Storage for SetNextWindow** functions
 struct ImGuiNextItemData;           // Storage for SetNextItem** functions
+struct ImGuiPlotCache;              // Storage for the min/max pyramid of a decimated plot (see SetNextPlotDataVersion())
 struct ImGuiPopupData;              // Storage for current popup stack
+struct ImGuiProfilerZone;           // Storage for one closed profiler zone (when IMGUI_ENABLE_PROFILER is defined)
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
 struct ImGuiTabBar;                 // Storage for a tab bar
 struct ImGuiTabItem;                // Storage for a tab item (within a tab bar)
 struct ImGuiWindow;                 // Storage for one window
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame)
+struct ImGuiWindowDrawListCache;    // Storage for the retained output of a window (ImGuiWindowFlags_CacheContents)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
 
 // Use your programming IDE "Go to definition" facility on the names of the center columns to find the actual flags/enum lists.
@@ -216,6 +234,20 @@ namespace ImStb
 #endif
 #endif // #ifndef IM_DEBUG_BREAK
 
+// Debug Tools: Allocations tracking (see IMGUI_ENABLE_ALLOC_TRACKING in imconfig.h)
+// Allocations made until the end of the current scope are attributed to _NAME instead of the file/line of their IM_ALLOC()/IM_NEW() call.
+#ifdef IMGUI_ENABLE_ALLOC_TRACKING
+struct IMGUI_API ImGuiAllocScope
+{
+    const char*     BackupName;
+    ImGuiAllocScope(const char* name);
+    ~ImGuiAllocScope();
+};
+#define IMGUI_ALLOC_SCOPE(_NAME)        ImGuiAllocScope imgui_alloc_scope(_NAME)    // Only one per scope
+#else
+#define IMGUI_ALLOC_SCOPE(_NAME)        do { } while (0)
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Generic helpers
 // Note that the ImXXX helpers functions are lower-level than ImGui functions.
@@ -236,11 +268,13 @@ namespace ImStb
 // - Helper: ImBitVector
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
+// - Helper: ImRectGrid
 //-----------------------------------------------------------------------------
 
 // Helpers: Hashing
 IMGUI_API ImU32         ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImU32         ImHashStr(const char* data, size_t data_size = 0, ImU32 seed = 0);
+IMGUI_API const char*   ImHashGetFunctionName();    // "CRC32" (default), "CRC32C" or "Murmur3", see IMGUI_USE_xxx_HASH in imconfig.h
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline ImU32     ImHash(const void* data, int size, ImU32 seed = 0) { return size ? ImHashData(data, (size_t)size, seed) : ImHashStr((const char*)data, 0, seed); } // [moved to ImHashStr/ImHashData in 1.68]
 #endif
@@ -481,13 +515,17 @@ struct IMGUI_API ImPool
     T*          GetByKey(ImGuiID key)               { int idx = Map.GetInt(key, -1); return (idx != -1) ? &Buf[idx] : NULL; }
     T*          GetByIndex(ImPoolIdx n)             { return &Buf[n]; }
     ImPoolIdx   GetIndex(const T* p) const          { IM_ASSERT(p >= Buf.Data && p < Buf.Data + Buf.Size); return (ImPoolIdx)(p - Buf.Data); }
-    T*          GetOrAddByKey(ImGuiID key)          { int* p_idx = Map.GetIntRef(key, -1); if (*p_idx != -1) return &Buf[*p_idx]; *p_idx = FreeIdx; return Add(); }
+    T*          GetOrAddByKey(ImGuiID key)          { IMGUI_ALLOC_SCOPE("ImPool"); int* p_idx = Map.GetIntRef(key, -1); if (*p_idx != -1) return &Buf[*p_idx]; *p_idx = FreeIdx; return Add(); }
     bool        Contains(const T* p) const          { return (p >= Buf.Data && p < Buf.Data + Buf.Size); }
+#ifndef IMGUI_USE_HASHED_STORAGE
     void        Clear()                             { for (int n = 0; n < Map.Data.Size; n++) { int idx = Map.Data[n].val_i; if (idx != -1) Buf[idx].~T(); } Map.Clear(); Buf.clear(); FreeIdx = 0; }
-    T*          Add()                               { int idx = FreeIdx; if (idx == Buf.Size) { Buf.resize(Buf.Size + 1); FreeIdx++; } else { FreeIdx = *(int*)&Buf[idx]; } IM_PLACEMENT_NEW(&Buf[idx]) T(); return &Buf[idx]; }
+#else
+    void        Clear()                             { for (int n = 0; n < Map.Data.Size; n++) { int idx = Map.Data[n].val_i; if (Map.Data[n].key != 0 && idx != -1) Buf[idx].~T(); } if (Map.ZeroKeyUsed && Map.ZeroKeyPair.val_i != -1) Buf[Map.ZeroKeyPair.val_i].~T(); Map.Clear(); Buf.clear(); FreeIdx = 0; }
+#endif
+    T*          Add()                               { IMGUI_ALLOC_SCOPE("ImPool"); int idx = FreeIdx; if (idx == Buf.Size) { Buf.resize(Buf.Size + 1); FreeIdx++; } else { FreeIdx = *(int*)&Buf[idx]; } IM_PLACEMENT_NEW(&Buf[idx]) T(); return &Buf[idx]; }
     void        Remove(ImGuiID key, const T* p)     { Remove(key, GetIndex(p)); }
     void        Remove(ImGuiID key, ImPoolIdx idx)  { Buf[idx].~T(); *(int*)&Buf[idx] = FreeIdx; FreeIdx = idx; Map.SetInt(key, -1); }
-    void        Reserve(int capacity)               { Buf.reserve(capacity); Map.Data.reserve(capacity); }
+    void        Reserve(int capacity)               { IMGUI_ALLOC_SCOPE("ImPool"); Buf.reserve(capacity); Map.Data.reserve(capacity); }
     int         GetSize() const                     { return Buf.Size; }
 };
 
@@ -504,7 +542,7 @@ struct IMGUI_API ImChunkStream
     void    clear()                     { Buf.clear(); }
     bool    empty() const               { return Buf.Size == 0; }
     int     size() const                { return Buf.Size; }
-    T*      alloc_chunk(size_t sz)      { size_t HDR_SZ = 4; sz = ((HDR_SZ + sz) + 3u) & ~3u; int off = Buf.Size; Buf.resize(off + (int)sz); ((int*)(void*)(Buf.Data + off))[0] = (int)sz; return (T*)(void*)(Buf.Data + off + (int)HDR_SZ); }
+    T*      alloc_chunk(size_t sz)      { IMGUI_ALLOC_SCOPE("ImChunkStream"); size_t HDR_SZ = 4; sz = ((HDR_SZ + sz) + 3u) & ~3u; int off = Buf.Size; Buf.resize(off + (int)sz); ((int*)(void*)(Buf.Data + off))[0] = (int)sz; return (T*)(void*)(Buf.Data + off + (int)HDR_SZ); }
     T*      begin()                     { size_t HDR_SZ = 4; if (!Buf.Data) return NULL; return (T*)(void*)(Buf.Data + HDR_SZ); }
     T*      next_chunk(T* p)            { size_t HDR_SZ = 4; IM_ASSERT(p >= begin() && p < end()); p = (T*)(void*)((char*)(void*)p + chunk_size(p)); if (p == (T*)(void*)((char*)end() + HDR_SZ)) return (T*)0; IM_ASSERT(p < end()); return p; }
     int     chunk_size(const T* p)      { return ((const int*)p)[-1]; }
@@ -513,6 +551,57 @@ struct IMGUI_API ImChunkStream
     T*      ptr_from_offset(int off)    { IM_ASSERT(off >= 4 && off < Buf.Size); return (T*)(void*)(Buf.Data + off); }
 };
 
+// Helper: ImRectGrid
+// Uniform grid over a set of rectangles, to find the front-most rectangle containing a point without testing all of them.
+// Add() rectangles in back-to-front order, call Build() once, then FindFrontMost() any number of times.
+// This is used by FindHoveredWindow() and may be used to hit-test custom canvases with many items.
+struct IMGUI_API ImRectGrid
+{
+    ImVector<ImRect> Rects;         // Rectangles, in back-to-front order
+    ImVector<int>   CellsStart;     // Offset of the first entry of each cell in CellsRects[] (CellsX * CellsY + 1 values)
+    ImVector<int>   CellsRects;     // Indices of the rectangles overlapping each cell, back-to-front
+    ImRect          Bounds;         // Bounding box of all rectangles
+    ImVec2          CellsScale;     // Cells per unit
+    int             CellsX, CellsY;
+
+    ImRectGrid()                    { Clear(); }
+    void            Clear()         { Rects.resize(0); CellsStart.resize(0); CellsRects.resize(0); Bounds = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX); CellsScale = ImVec2(0.0f, 0.0f); CellsX = CellsY = 0; }
+    void            ClearFreeMemory() { Rects.clear(); CellsStart.clear(); CellsRects.clear(); Clear(); }
+    int             Add(const ImRect& r) { Rects.push_back(r); return Rects.Size - 1; }
+    void            Build();
+    int             FindFrontMost(const ImVec2& p) const;   // Return index of the front-most rectangle containing 'p', or -1
+    int             GetCellX(float x) const { return (int)ImClamp((x - Bounds.Min.x) * CellsScale.x, 0.0f, (float)(CellsX - 1)); }
+    int             GetCellY(float y) const { return (int)ImClamp((y - Bounds.Min.y) * CellsScale.y, 0.0f, (float)(CellsY - 1)); }
+};
+
+// Helper: ImFrameArena
+// Bump allocator for temporary memory which only needs to stay valid until the next NewFrame() (e.g. sort buffers in EndFrame(), clipboard conversions).
+// Allocations are 16 bytes aligned and never freed individually: Reset() releases all of them at once.
+// Blocks grow by doubling. Reset() only keeps the last (largest) block, so steady-state frames don't touch the heap.
+// Constructors/destructors of allocated types are not called.
+struct ImFrameArenaBlock
+{
+    ImFrameArenaBlock*  Prev;
+    size_t              Size;       // Usable bytes, following the (16 bytes aligned) header
+    size_t              Used;
+};
+
+struct IMGUI_API ImFrameArena
+{
+    ImFrameArenaBlock*  Block;          // Current block, linked to the previous blocks of the frame
+    size_t              BlockMinSize;   // Minimum size of a block
+    size_t              FrameBytes;     // Bytes allocated since the last Reset()
+    size_t              LastFrameBytes; // Bytes allocated between the two last calls to Reset()
+
+    ImFrameArena()      { Block = NULL; BlockMinSize = 16 * 1024; FrameBytes = LastFrameBytes = 0; }
+    ~ImFrameArena()     { ClearFreeMemory(); }
+    void*               Alloc(size_t size);
+    template<typename T> T* AllocArray(int count) { return (T*)Alloc((size_t)count * sizeof(T)); }
+    void                Reset();
+    void                ClearFreeMemory();
+    size_t              GetCapacity() const { size_t capacity = 0; for (const ImFrameArenaBlock* block = Block; block != NULL; block = block->Prev) capacity += block->Size; return capacity; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawList support
 //-----------------------------------------------------------------------------
@@ -538,6 +627,9 @@ struct IMGUI_API ImDrawListSharedData
     float           CircleSegmentMaxError;      // Number of circle segments to use per pixel of radius for AddCircle() etc
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
+    ImFontTextCache* TextCache;                 // Cache of text layouts used by ImFont::RenderText() (NULL if disabled, see io.ConfigTextCacheBudget)
+    int             BuffersShrinkFrames;        // Shrink draw list buffers after this number of frames of low usage, 0 to never shrink (see io.ConfigDrawListsShrinkFrames)
+    bool            BuffersPreSize;             // Grow nearly full draw list buffers when they are cleared (see io.ConfigDrawListsPreSize)
 
     // [Internal] Lookup tables
     ImVec2          ArcFastVtx[12 * IM_DRAWLIST_ARCFAST_TESSELLATION_MULTIPLIER];  // FIXME: Bake rounded corners fill/borders in atlas
@@ -547,12 +639,115 @@ struct IMGUI_API ImDrawListSharedData
     void SetCircleSegmentMaxError(float max_error);
 };
 
+// Glyph quad of a cached text layout, relative to the (pixel aligned) text position
+struct ImFontTextCacheQuad
+{
+    ImVec2          Min, Max;
+    ImVec2          UvMin, UvMax;
+};
+
+// Layout of one text in ImFontTextCache
+struct ImFontTextCacheEntry
+{
+    ImGuiID         Hash;                       // Hash of (Font, Size, WrapWidth) and text contents
+    const ImFont*   Font;
+    float           Size;
+    float           WrapWidth;
+    int             AtlasBuildCount;            // Value of Font->ContainerAtlas->BuildCount when the layout was calculated
+    int             TextOffset;                 // Offset of text contents in ImFontTextCache::TextBuf[], to resolve hash collisions
+    int             TextLength;
+    int             QuadsOffset;                // Offset of glyph quads in ImFontTextCache::Quads[] (-1 until the text is first rendered)
+    int             QuadsCount;
+    ImVec4          QuadsBounds;                // Bounding box of glyph quads, relative to text position
+    ImVec2          TextSize;                   // Result of CalcTextSizeA() with max_width = FLT_MAX
+    int             LastUsedFrame;
+};
+
+// Cache of text layouts, so text which doesn't change from one frame to the other (e.g. labels) skips UTF-8 decoding and glyph lookups:
+// CalcTextSize() returns the cached size, and ImFont::RenderText() translates cached glyph quads when they are fully inside the clipping rectangle.
+// Owned by ImGuiContext and enabled with io.ConfigTextCacheBudget. Storage is contiguous and least recently used entries are evicted by
+// GarbageCollect() once per frame, so memory usage may exceed the budget by the amount of new text submitted in a single frame.
+// Entries are indexed by an open-addressing hash table (linear probing): as entries are only removed by rebuilding storage, it never needs tombstones.
+// Text is only added once it has been seen on a previous frame (in Seen[], a direct-mapped table of recent hashes), so text changing every frame only costs hashing.
+// Short text is rendered faster than it is hashed, and hashing cost depends on the ID hash function (see IMGUI_USE_WORD_HASH in imconfig.h).
+#define IMGUI_TEXT_CACHE_MIN_LENGTH     16      // Shorter text are never cached
+#define IMGUI_TEXT_CACHE_MAX_LENGTH     256     // Longer text are never cached (large text blocks are already clipped to their visible lines)
+#define IMGUI_TEXT_CACHE_SEEN_COUNT     4096    // Size of the Seen[] table (power of two)
+struct IMGUI_API ImFontTextCache
+{
+    ImVector<ImFontTextCacheEntry>  Entries;
+    ImVector<int>                   Buckets;    // Index in Entries[] or -1. Size is zero or a power of two, at least twice Entries.Size
+    ImVector<char>                  TextBuf;
+    ImVector<ImFontTextCacheQuad>   Quads;
+    ImVector<ImU64>                 Seen;       // Frame << 32 | Hash, allocated on first use
+    int                             Frame;      // Incremented by GarbageCollect()
+    int                             HitCount;   // Statistics for Metrics window
+    int                             MissCount;
+    int                             EvictCount;
+
+    ImFontTextCache()                           { Frame = 0; HitCount = MissCount = EvictCount = 0; }
+    void                    Clear()             { Entries.clear(); Buckets.clear(); TextBuf.clear(); Quads.clear(); Seen.clear(); }
+    int                     GetMemoryUsage() const;
+    ImFontTextCacheEntry*   GetEntry(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end); // NULL if text isn't cached (yet)
+    void                    GarbageCollect(int memory_budget);
+    void                    RebuildBuckets(int buckets_count);
+};
+
+enum ImDrawListDeferredCmdType
+{
+    ImDrawListDeferredCmdType_Polyline,
+    ImDrawListDeferredCmdType_ConvexPolyFilled,
+    ImDrawListDeferredCmdType_Text
+};
+
+// A primitive recorded by ImDrawList when using ImDrawListFlags_DeferTessellation.
+// Its vertices and indices are already reserved in the draw list buffers, and will be written by ImDrawList::_FlushDeferred().
+struct ImDrawListDeferredCmd
+{
+    ImU8            Type;                       // ImDrawListDeferredCmdType
+    bool            AntiAliased;                // Polyline, ConvexPolyFilled
+    bool            Closed;                     // Polyline
+    bool            CpuFineClip;                // Text
+    ImU32           Col;
+    float           Size;                       // Polyline: thickness, Text: font size
+    int             VtxOffset;                  // Offset of reserved vertices in VtxBuffer
+    int             IdxOffset;                  // Offset of reserved indices in IdxBuffer
+    int             VtxCount;                   // Number of reserved vertices (text may use less, the remaining ones are turned into degenerate triangles)
+    int             IdxCount;                   // Number of reserved indices
+    unsigned int    VtxCurrentIdx;              // Value of ImDrawList::_VtxCurrentIdx for the first reserved vertex
+    int             DataOffset;                 // Offset in ImDrawListDeferred::Points[] or ImDrawListDeferred::Text[]
+    int             DataSize;                   // Number of points or characters
+    const ImFont*   Font;                       // Text
+    ImVec2          Pos;                        // Text: pixel aligned position of the first line (wrapping/new lines restart at Pos.x)
+    float           PosY;                       // Text: position of the first visible line
+    float           WrapWidth;                  // Text
+    ImVec4          ClipRect;                   // Text
+};
+
+// Storage for primitives recorded by an ImDrawList using ImDrawListFlags_DeferTessellation (see ImDrawList::_FlushDeferred())
+struct ImDrawListDeferred
+{
+    ImVector<ImDrawListDeferredCmd> Cmds;
+    ImVector<ImVec2>                Points;     // Copy of AddPolyline()/AddConvexPolyFilled() points
+    ImVector<char>                  Text;       // Copy of AddText() strings (the source buffers may be reused before Render())
+
+    void Clear()    { Cmds.resize(0); Points.resize(0); Text.resize(0); }
+};
+
 struct ImDrawDataBuilder
 {
     ImVector<ImDrawList*>   Layers[2];           // Global layers for: regular, tooltip
+    ImVector<ImDrawVert>    ArenaVtxBuffer;      // Storage for ImDrawData::ArenaVtxBuffer, ArenaIdxBuffer, ArenaCmdBuffer (see ImGuiBackendFlags_RendererHasDrawDataArena)
+    ImVector<ImDrawIdx>     ArenaIdxBuffer;
+    ImVector<ImDrawCmd>     ArenaCmdBuffer;
+    ImVector<int>           ArenaListOffsets;    // Offset of the first command, vertex and index of each draw list in the arena (3 values per draw list)
+    ImVector<bool>          ArenaCmdUnclipped;   // For each arena command, whether its vertices are all within its ClipRect (see io.ConfigDrawDataMergeCommands)
+    int                     ArenaCmdMergedCount; // Number of arena commands merged into a previous command during the last Render()
+
+    ImDrawDataBuilder()     { ArenaCmdMergedCount = 0; }
 
     void Clear()            { for (int n = 0; n < IM_ARRAYSIZE(Layers); n++) Layers[n].resize(0); }
-    void ClearFreeMemory()  { for (int n = 0; n < IM_ARRAYSIZE(Layers); n++) Layers[n].clear(); }
+    void ClearFreeMemory()  { for (int n = 0; n < IM_ARRAYSIZE(Layers); n++) Layers[n].clear(); ArenaVtxBuffer.clear(); ArenaIdxBuffer.clear(); ArenaCmdBuffer.clear(); ArenaListOffsets.clear(); ArenaCmdUnclipped.clear(); }
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
@@ -849,9 +1044,11 @@ struct IMGUI_API ImGuiInputTextState
     ImGuiID                 ID;                     // widget id owning the text state
     int                     CurLenW, CurLenA;       // we need to maintain our buffer length in both UTF-8 and wchar format. UTF-8 length is valid even if TextA is not.
     ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
-    ImVector<char>          TextA;                  // temporary UTF8 buffer for callbacks and other operations. this is not updated in every code-path! size=capacity.
+    ImVector<char>          TextA;                  // UTF-8 copy of TextW for display, callbacks and other operations, updated by edits. size=capacity.
     ImVector<char>          InitialTextA;           // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
-    bool                    TextAIsValid;           // temporary UTF8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
+    ImVector<int>           LineStartsW;            // offset of the beginning of each line in TextW (LineStartsW[0] == 0), updated by edits
+    ImVector<int>           LineStartsA;            // offset of the beginning of each line in TextA
+    bool                    TextAIsValid;           // TextA and LineStartsA are not valid when the text has been refreshed from a read-only user buffer
     int                     BufCapacityA;           // end-user buffer capacity
     float                   ScrollX;                // horizontal scrolling/offset
     ImStb::STB_TexteditState Stb;                   // state for stb_textedit.h
@@ -863,8 +1060,8 @@ struct IMGUI_API ImGuiInputTextState
     void*                   UserCallbackData;       // "
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; LineStartsW.resize(1); LineStartsA.resize(1); LineStartsW[0] = LineStartsA[0] = 0; CursorClamp(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStartsW.clear(); LineStartsA.clear(); }
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
     int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
@@ -883,12 +1080,13 @@ struct ImGuiPopupData
     ImGuiID             PopupId;        // Set on OpenPopup()
     ImGuiWindow*        Window;         // Resolved on BeginPopup() - may stay unresolved if user never calls OpenPopup()
     ImGuiWindow*        SourceWindow;   // Set on OpenPopup() copy of NavWindow at the time of opening the popup
+    ImGuiWindow*        ParentWindow;   // Set on OpenPopup(), current window at the time of opening the popup
     int                 OpenFrameCount; // Set on OpenPopup()
     ImGuiID             OpenParentId;   // Set on OpenPopup(), we need this to differentiate multiple menu sets from each others (e.g. inside menu bar vs loose menu items)
     ImVec2              OpenPopupPos;   // Set on OpenPopup(), preferred popup position (typically == OpenMousePos when using mouse)
     ImVec2              OpenMousePos;   // Set on OpenPopup(), copy of mouse position at the time of opening popup
 
-    ImGuiPopupData() { PopupId = 0; Window = SourceWindow = NULL; OpenFrameCount = -1; OpenParentId = 0; }
+    ImGuiPopupData() { PopupId = 0; Window = SourceWindow = ParentWindow = NULL; OpenFrameCount = -1; OpenParentId = 0; }
 };
 
 struct ImGuiNavMoveResult
@@ -915,7 +1113,8 @@ enum ImGuiNextWindowDataFlags_
     ImGuiNextWindowDataFlags_HasSizeConstraint  = 1 << 4,
     ImGuiNextWindowDataFlags_HasFocus           = 1 << 5,
     ImGuiNextWindowDataFlags_HasBgAlpha         = 1 << 6,
-    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7
+    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7,
+    ImGuiNextWindowDataFlags_HasContentHash     = 1 << 8
 };
 
 // Storage for SetNexWindow** functions
@@ -935,6 +1134,7 @@ struct ImGuiNextWindowData
     ImGuiSizeCallback           SizeCallback;
     void*                       SizeCallbackUserData;
     float                       BgAlphaVal;             // Override background alpha
+    ImGuiID                     ContentHashVal;         // Set by SetNextWindowContentHash()
     ImVec2                      MenuBarOffsetMinVal;    // *Always on* This is not exposed publicly, so we don't clear it.
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
@@ -943,9 +1143,10 @@ struct ImGuiNextWindowData
 
 enum ImGuiNextItemDataFlags_
 {
-    ImGuiNextItemDataFlags_None     = 0,
-    ImGuiNextItemDataFlags_HasWidth = 1 << 0,
-    ImGuiNextItemDataFlags_HasOpen  = 1 << 1
+    ImGuiNextItemDataFlags_None                 = 0,
+    ImGuiNextItemDataFlags_HasWidth             = 1 << 0,
+    ImGuiNextItemDataFlags_HasOpen              = 1 << 1,
+    ImGuiNextItemDataFlags_HasPlotDataVersion   = 1 << 2
 };
 
 struct ImGuiNextItemData
@@ -955,11 +1156,49 @@ struct ImGuiNextItemData
     ImGuiID                     FocusScopeId;   // Set by SetNextItemMultiSelectData() (!= 0 signify value has been set, so it's an alternate version of HasSelectionData, we don't use Flags for this because they are cleared too early. This is mostly used for debugging)
     ImGuiCond                   OpenCond;
     bool                        OpenVal;        // Set by SetNextItemOpen()
+    int                         PlotDataVersion;// Set by SetNextPlotDataVersion()
 
     ImGuiNextItemData()         { memset(this, 0, sizeof(*this)); }
     inline void ClearFlags()    { Flags = ImGuiNextItemDataFlags_None; } // Also cleared manually by ItemAdd()!
 };
 
+// Storage for PlotEx() decimation, enabled with SetNextPlotDataVersion().
+// MinMax[] holds a pyramid of (min,max) pairs: level 0 covers blocks of IMGUI_PLOT_CACHE_BLOCK_SIZE samples, each next level covers two blocks of the previous one.
+// Any range of samples can then be reduced in O(IMGUI_PLOT_CACHE_BLOCK_SIZE + log N) calls/reads, and the pyramid is only rebuilt when the data identity or version changes.
+#define IMGUI_PLOT_CACHE_BLOCK_SIZE     8
+struct ImGuiPlotCache
+{
+    ImGuiID             ID;                 // Plot item ID
+    const void*         Data;               // Values pointer (for array plots) or user data pointer (for plots using a getter)
+    int                 Count;
+    int                 Stride;             // For array plots (0 for plots using a getter)
+    int                 Version;            // Set by SetNextPlotDataVersion()
+    float               LastTimeUsed;       // For garbage collection, using io.ConfigWindowsMemoryCompactTimer
+    float               MinValue, MaxValue; // Over all values, used for auto-scaling
+    ImVector<float>     MinMax;
+    ImVector<int>       LevelOffsets;       // Offset of each level in MinMax[] (in floats)
+
+    ImGuiPlotCache()    { ID = 0; Data = NULL; Count = Stride = Version = 0; LastTimeUsed = 0.0f; MinValue = MaxValue = 0.0f; }
+};
+
+// Hue wheel mesh of ColorPicker4(), reused by RenderColorPickerHueWheel() for pickers of the same size and sub-pixel position.
+// The IMGUI_COLOR_PICKER_MESH_CACHE_SIZE most recently used meshes are kept.
+#define IMGUI_COLOR_PICKER_MESH_CACHE_SIZE  8
+struct ImGuiColorPickerMesh
+{
+    float               RadiusInner, RadiusOuter;
+    ImVec2              CenterFrac;         // Sub-pixel position of the center (vertices are relative to the integer part of the center)
+    ImDrawListFlags     Flags;              // ImDrawListFlags_AntiAliasedLines of the draw list
+    ImVec2              TexUvWhitePixel;
+    int                 LastFrameUsed;
+    ImVector<ImVec2>    VtxPos;
+    ImVector<ImVec2>    VtxUV;
+    ImVector<ImU32>     VtxCol;             // At full alpha
+    ImVector<ImDrawIdx> IdxBuffer;          // Relative to the first vertex
+
+    ImGuiColorPickerMesh() { RadiusInner = RadiusOuter = 0.0f; Flags = ImDrawListFlags_None; LastFrameUsed = -1; }
+};
+
 struct ImGuiShrinkWidthItem
 {
     int         Index;
@@ -1092,6 +1331,59 @@ struct ImGuiSettingsHandler
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+//-----------------------------------------------------------------------------
+// [SECTION] Profiler support
+//-----------------------------------------------------------------------------
+
+// Scoped CPU zones recorded around the main sub-steps of NewFrame(), Begin(), End(), ItemAdd(), EndFrame() and Render().
+// Compiled out unless IMGUI_ENABLE_PROFILER is defined in imconfig.h. Closed zones are stored in a ring buffer in the
+// context (displayed in Metrics->Profiler) and forwarded to an optional user callback, see SetProfilerZoneCallback().
+#ifndef IMGUI_PROFILER_ZONES_CAPACITY
+#define IMGUI_PROFILER_ZONES_CAPACITY   8192    // Number of zones kept in the ring buffer
+#endif
+
+struct ImGuiProfilerZone
+{
+    const char*     Name;               // Static string identifying the zone
+    ImU64           TicksBegin;         // Timestamps, see ProfilerGetTicks()/ProfilerGetTicksPerSecond()
+    ImU64           TicksEnd;
+    int             Depth;              // Nesting depth (0 for top-level zones)
+    int             FrameCount;         // Value of g.FrameCount when the zone was closed
+};
+
+typedef void (*ImGuiProfilerZoneCallback)(const ImGuiProfilerZone* zone, void* user_data);
+
+#ifdef IMGUI_ENABLE_PROFILER
+struct ImGuiProfilerZoneScope
+{
+    const char*     Name;
+    ImU64           TicksBegin;
+    ImGuiProfilerZoneScope(const char* name);
+    ~ImGuiProfilerZoneScope();
+};
+#define IMGUI_PROFILER_ZONE(_NAME)      ImGuiProfilerZoneScope imgui_profiler_zone(_NAME)   // Open a zone until the end of the current scope (only one per scope)
+#else
+#define IMGUI_PROFILER_ZONE(_NAME)      do { } while (0)
+#endif
+
+// Allocations tracking: compiled out unless IMGUI_ENABLE_ALLOC_TRACKING is defined in imconfig.h. Sites are stored in a fixed-size
+// table in the context (so recording never allocates), displayed in Metrics->Allocations. See IMGUI_ALLOC_SCOPE().
+// Allocations made by jobs running on other threads (see io.ParallelForFn) are recorded per site without synchronization: site counts may be off
+// (io.MetricsActiveAllocations and io.MetricsFrameAllocations are updated atomically).
+#ifndef IMGUI_ALLOC_SITES_CAPACITY
+#define IMGUI_ALLOC_SITES_CAPACITY      256     // Number of call sites, the last one collects the allocations of sites which didn't fit
+#endif
+
+struct ImGuiAllocSite
+{
+    const char*     Name;               // IMGUI_ALLOC_SCOPE() name, or file name of the IM_ALLOC()/IM_NEW() call
+    int             Line;               // Line of the IM_ALLOC()/IM_NEW() call, 0 for scopes
+    int             Count;              // Number of allocations since the context was created
+    ImU64           Bytes;              // Total size of those allocations
+    int             CountThisFrame;     // Number of allocations since the last NewFrame()
+    int             CountLastFrame;     // Number of allocations during the last frame (from NewFrame() to NewFrame())
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiContext (main imgui context)
 //-----------------------------------------------------------------------------
@@ -1102,10 +1394,12 @@ struct ImGuiContext
     bool                    FontAtlasOwnedByContext;            // IO.Fonts-> is owned by the ImGuiContext and will be destructed along with it.
     ImGuiIO                 IO;
     ImGuiStyle              Style;
+    ImGuiID                 StyleHash;                          // Hash of Style, computed by NewFrame() for ImGuiWindowFlags_CacheContents. Changes made by PushStyleColor()/PushStyleVar() are hashed separately.
     ImFont*                 Font;                               // (Shortcut) == FontStack.empty() ? IO.Font : FontStack.back()
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize(). Text height for current window.
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Base text height.
     ImDrawListSharedData    DrawListSharedData;
+    ImFontTextCache         TextCache;                          // Exposed to draw lists via DrawListSharedData.TextCache when io.ConfigTextCacheBudget > 0
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -1120,9 +1414,14 @@ struct ImGuiContext
     // Windows state
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
     ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Windows, sorted in focus order, back to front. (FIXME: We could only store root windows here! Need to sort out the Docking equivalent which is RootWindowDockStop and is unfortunately a little more dynamic)
-    ImVector<ImGuiWindow*>  WindowsTempSortBuffer;              // Temporary buffer used in EndFrame() to reorder windows so parents are kept before their child
     ImVector<ImGuiWindow*>  CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
+    ImVector<ImGuiWindow*>  WindowsLookupCache;                 // Direct-mapped cache in front of WindowsById, also used by BeginChild() to find child windows without building their name. Size is zero or a power of two.
+    ImRectGrid              WindowsHitGrid;                     // Hovering rectangles of windows accepting mouse inputs, built at the end of EndFrame() for the next FindHoveredWindow()
+    ImVector<ImGuiWindow*>  WindowsHitGridWindows;              // Window of each rectangle of WindowsHitGrid
+    ImVec2                  WindowsHitGridPadding[2];           // Paddings used to build WindowsHitGrid (regular, resize from edges)
+    bool                    WindowsHitGridValid;                // WindowsHitGrid matches windows rectangles and display order (cleared by NewFrame() and any change of display order)
+    ImGuiWindow*            WindowsLookupHint;                  // Window found by BeginChild() for the next Begin() call, used when the name pointer matches its Name.
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
     ImGuiWindow*            HoveredWindow;                      // Will catch mouse inputs
@@ -1231,6 +1530,7 @@ struct ImGuiContext
     // Render
     ImDrawData              DrawData;                           // Main ImDrawData instance to pass render information to the user
     ImDrawDataBuilder       DrawDataBuilder;
+    ImVector<ImDrawList*>   DrawListsToFlush;                   // Window draw lists with primitives to tessellate in Render() (see io.ConfigDrawListsDeferTessellation)
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImDrawList              BackgroundDrawList;                 // First draw list to be rendered.
     ImDrawList              ForegroundDrawList;                 // Last draw list to be rendered. This is where we the render software mouse cursor (if io.MouseDrawCursor is set) and most debug overlays.
@@ -1271,6 +1571,7 @@ struct ImGuiContext
     float                   ColorEditLastSat;                   // Backup of last Saturation associated to LastColor[3], so we can restore Saturation in lossy RGB<>HSV round trips
     float                   ColorEditLastColor[3];
     ImVec4                  ColorPickerRef;                     // Initial/reference color at the time of opening the color picker.
+    ImVector<ImGuiColorPickerMesh*> ColorPickerMeshes;          // Hue wheel meshes (see RenderColorPickerHueWheel())
     bool                    DragCurrentAccumDirty;
     float                   DragCurrentAccum;                   // Accumulator for dragging modification. Always high-precision, not rounded by end-user precision settings
     float                   DragSpeedDefaultRatio;              // If speed == 0.0f, uses (max-min) * DragSpeedDefaultRatio
@@ -1278,6 +1579,8 @@ struct ImGuiContext
     int                     TooltipOverrideCount;
     ImVector<char>          ClipboardHandlerData;               // If no custom clipboard handler is defined
     ImVector<ImGuiID>       MenusIdSubmittedThisFrame;          // A list of menu IDs that were rendered at least once
+    ImVector<ImGuiPlotCache*> PlotCaches;                     // Decimated plots (see SetNextPlotDataVersion()), garbage collected after io.ConfigWindowsMemoryCompactTimer
+    ImGuiStorage            PlotCachesById;                     // Map plot ID to index in PlotCaches[]
 
     // Platform support
     ImVec2                  PlatformImePos;                     // Cursor position request & last passed to the OS Input Method Editor
@@ -1285,6 +1588,7 @@ struct ImGuiContext
 
     // Settings
     bool                    SettingsLoaded;
+    bool                    SettingsHashMismatch;               // Set while loading .ini data written with a different ID hash function (see ImHashGetFunctionName()). Handlers storing ImGuiID values should discard them.
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
@@ -1305,6 +1609,25 @@ struct ImGuiContext
     bool                    DebugItemPickerActive;              // Item picker is active (started with DebugStartItemPicker())
     ImGuiID                 DebugItemPickerBreakId;             // Will call IM_DEBUG_BREAK() when encountering this id
 
+    // Profiler (only recorded when IMGUI_ENABLE_PROFILER is defined)
+    ImVector<ImGuiProfilerZone> ProfilerZones;                  // Ring buffer of the last IMGUI_PROFILER_ZONES_CAPACITY closed zones
+    int                     ProfilerZonesHead;                  // Index of the next zone to write into ProfilerZones[]
+    int                     ProfilerZonesCount;                 // Number of valid zones in ProfilerZones[]
+    int                     ProfilerDepth;                      // Nesting depth of currently opened zones
+    ImGuiProfilerZoneCallback ProfilerZoneCallback;             // Called every time a zone is closed, see SetProfilerZoneCallback()
+    void*                   ProfilerZoneCallbackUserData;
+
+    // Allocations tracking (only recorded when IMGUI_ENABLE_ALLOC_TRACKING is defined)
+    ImVector<ImGuiAllocSite> AllocSites;                        // IMGUI_ALLOC_SITES_CAPACITY entries, allocated by Initialize()
+    int                     AllocSitesCount;                    // Number of used entries in AllocSites[]
+    const char*             AllocScope;                         // Name of the innermost IMGUI_ALLOC_SCOPE(), if any
+
+    // Garbage collection (see io.ConfigWindowsMemoryCompactTimer, io.ConfigMemoryCompactBudget)
+    size_t                  GcMemoryUsage;                      // Capacity of windows transient buffers and input text state measured by the last budget check (only updated when io.ConfigMemoryCompactBudget > 0)
+    ImU64                   GcReclaimedBytes;                   // Total bytes freed by GcCompactTransientWindowBuffers() and GcCompactToMemoryBudget()
+    int                     GcCompactedWindowsCount;            // Number of inactive windows compacted to fit io.ConfigMemoryCompactBudget
+    int                     GcShrunkWindowsCount;               // Number of active windows whose draw list buffers were shrunk to fit io.ConfigMemoryCompactBudget
+
     // Misc
     float                   FramerateSecPerFrame[120];          // Calculate estimate of framerate for user over the last 2 seconds.
     int                     FramerateSecPerFrameIdx;
@@ -1313,6 +1636,8 @@ struct ImGuiContext
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
     char                    TempBuffer[1024*3+1];               // Temporary text buffer
+    ImFrameArena            FrameArena;                         // Temporary memory valid until the next NewFrame() (see ImFrameArena)
+    int                     FrameAllocationsCount;              // Number of MemAlloc() calls since the last NewFrame(), copied to io.MetricsFrameAllocations
 
     ImGuiContext(ImFontAtlas* shared_font_atlas) : BackgroundDrawList(&DrawListSharedData), ForegroundDrawList(&DrawListSharedData)
     {
@@ -1320,6 +1645,7 @@ struct ImGuiContext
         FontAtlasOwnedByContext = shared_font_atlas ? false : true;
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
+        StyleHash = 0;
         IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
         Time = 0.0f;
         FrameCount = 0;
@@ -1330,6 +1656,8 @@ struct ImGuiContext
         TestEngine = NULL;
 
         WindowsActiveCount = 0;
+        WindowsLookupHint = NULL;
+        WindowsHitGridValid = false;
         CurrentWindow = NULL;
         HoveredWindow = NULL;
         HoveredRootWindow = NULL;
@@ -1431,6 +1759,7 @@ struct ImGuiContext
         PlatformImePos = PlatformImeLastPos = ImVec2(FLT_MAX, FLT_MAX);
 
         SettingsLoaded = false;
+        SettingsHashMismatch = false;
         SettingsDirtyTimer = 0.0f;
 
         LogEnabled = false;
@@ -1444,11 +1773,23 @@ struct ImGuiContext
         DebugItemPickerActive = false;
         DebugItemPickerBreakId = 0;
 
+        ProfilerZonesHead = ProfilerZonesCount = ProfilerDepth = 0;
+        ProfilerZoneCallback = NULL;
+        ProfilerZoneCallbackUserData = NULL;
+
+        AllocSitesCount = 0;
+        AllocScope = NULL;
+
+        GcMemoryUsage = 0;
+        GcReclaimedBytes = 0;
+        GcCompactedWindowsCount = GcShrunkWindowsCount = 0;
+
         memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
         FramerateSecPerFrameIdx = 0;
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
         memset(TempBuffer, 0, sizeof(TempBuffer));
+        FrameAllocationsCount = 0;
     }
 };
 
@@ -1549,6 +1890,40 @@ struct IMGUI_API ImGuiWindowTempData
     }
 };
 
+// Storage for ImGuiWindowFlags_CacheContents: output of a previous frame, reused while none of the inputs of the window changed.
+// Buffers are swapped with the window ImDrawList rather than copied:
+// - in Begin(), after a frame whose output could be cached, to record it (the ImDrawList gets the old buffers, which are cleared).
+// - in Render(), on frames reusing the cache (Begin() returned false and the ImDrawList only received window decorations), to display it.
+// - in Begin() of the next frame, to swap them back.
+struct ImGuiWindowDrawListCache
+{
+    ImVector<ImDrawCmd>     CmdBuffer;
+    ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImDrawVert>    VtxBuffer;
+    unsigned int            VtxCurrentIdx;
+    ImGuiID                 Key;                // Hash of the window inputs when the output was recorded (0: empty/invalid)
+    ImGuiID                 KeyThisFrame;       // Hash of the window inputs of the current frame (0: output can't be cached, e.g. window is hovered)
+    ImVec2                  ContentMaxOffset;   // DC.CursorMaxPos - DC.CursorStartPos of the recorded frame, restored on cache hit to preserve ContentSize
+    int                     RenderedFrame;      // Last frame the window was added to the draw data
+    bool                    Hit;                // Reusing the recorded output this frame
+    bool                    Swapped;            // Recorded buffers are currently swapped into the window ImDrawList
+    int                     HitCount;           // Statistics for Metrics window
+    int                     MissCount;
+
+    ImGuiWindowDrawListCache()          { VtxCurrentIdx = 0; Key = KeyThisFrame = 0; RenderedFrame = -1; Hit = Swapped = false; HitCount = MissCount = 0; }
+    void    Swap(ImDrawList* draw_list)
+    {
+        // Keep both sets of buffers at their peak capacity, otherwise the smaller one would grow again on every frame it is swapped in.
+        ReserveSame(CmdBuffer, draw_list->CmdBuffer); ReserveSame(IdxBuffer, draw_list->IdxBuffer); ReserveSame(VtxBuffer, draw_list->VtxBuffer);
+        CmdBuffer.swap(draw_list->CmdBuffer); IdxBuffer.swap(draw_list->IdxBuffer); VtxBuffer.swap(draw_list->VtxBuffer); ImSwap(VtxCurrentIdx, draw_list->_VtxCurrentIdx);
+        draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+        draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    }
+    template<typename T>
+    static void ReserveSame(ImVector<T>& a, ImVector<T>& b) { if (a.Capacity < b.Capacity) a.reserve(b.Capacity); else if (b.Capacity < a.Capacity) b.reserve(a.Capacity); }
+    void    ClearFreeMemory()           { CmdBuffer.clear(); IdxBuffer.clear(); VtxBuffer.clear(); VtxCurrentIdx = 0; Key = 0; Swapped = false; }
+};
+
 // Storage for one window
 struct IMGUI_API ImGuiWindow
 {
@@ -1634,6 +2009,8 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
 
+    ImGuiWindowDrawListCache DrawListCache;                     // Retained output when using ImGuiWindowFlags_CacheContents
+
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
     ~ImGuiWindow();
@@ -1992,6 +2369,7 @@ namespace ImGui
     IMGUI_API void          ColorTooltip(const char* text, const float* col, ImGuiColorEditFlags flags);
     IMGUI_API void          ColorEditOptionsPopup(const float* col, ImGuiColorEditFlags flags);
     IMGUI_API void          ColorPickerOptionsPopup(const float* ref_col, ImGuiColorEditFlags flags);
+    IMGUI_API void          RenderColorPickerHueWheel(ImDrawList* draw_list, ImVec2 center, float radius_inner, float radius_outer, float alpha, bool use_cache = true);
 
     // Plot
     IMGUI_API int           PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size);
@@ -2003,11 +2381,20 @@ namespace ImGui
     // Garbage collection
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
     IMGUI_API void          GcAwakeTransientWindowBuffers(ImGuiWindow* window);
+    IMGUI_API size_t        GcCalcTransientWindowBuffersSize(ImGuiWindow* window);
+    IMGUI_API void          GcCompactToMemoryBudget(size_t budget);
+    IMGUI_API void          GcCompactPlotCaches(float memory_compact_start_time);
 
     // Debug Tools
     inline void             DebugDrawItemRect(ImU32 col = IM_COL32(255,0,0,255))    { ImGuiContext& g = *GImGui; ImGuiWindow* window = g.CurrentWindow; GetForegroundDrawList(window)->AddRect(window->DC.LastItemRect.Min, window->DC.LastItemRect.Max, col); }
     inline void             DebugStartItemPicker()                                  { ImGuiContext& g = *GImGui; g.DebugItemPickerActive = true; }
 
+    // Profiler (zones are only recorded when IMGUI_ENABLE_PROFILER is defined, see IMGUI_PROFILER_ZONE())
+    IMGUI_API ImU64         ProfilerGetTicks();
+    IMGUI_API ImU64         ProfilerGetTicksPerSecond();
+    IMGUI_API void          ProfilerZoneEnd(const char* name, ImU64 ticks_begin);
+    IMGUI_API void          SetProfilerZoneCallback(ImGuiProfilerZoneCallback callback, void* user_data);   // Forward closed zones to your own tracer
+
 } // namespace ImGui
 
 // ImFontAtlas internals
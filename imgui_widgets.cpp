@@ -116,6 +116,10 @@ static const ImU64          IM_U64_MAX = (2ULL * 9223372036854775807LL + 1);
 static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data);
 static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
+static void             InputTextLineIndexRebuild(ImGuiInputTextState* state);
+static int              InputTextLineIndexFind(const ImGuiInputTextState* state, int pos_w);
+static int              InputTextOffsetWToA(const ImGuiInputTextState* state, int pos_w);
+static void             InputTextSyncTextAFromTextW(ImGuiInputTextState* state, int buf_size);
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
@@ -244,6 +248,60 @@ void ImGui::TextUnformatted(const char* text, const char* text_end)
     TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
 }
 
+// Display a large append-only text buffer using a persistent line index (see ImGuiTextIndex)
+// - The index is brought up to date with the text appended since the previous call, and widths of new complete lines are measured once.
+// - Only the visible lines are rendered, so the cost per frame is O(appended text + visible lines) instead of O(text).
+void ImGui::TextUnformattedIndexed(const char* text, const char* text_end, ImGuiTextIndex* index)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(text != NULL && index != NULL);
+    if (text_end == NULL)
+        text_end = text + strlen(text); // FIXME-OPT
+    if (g.LogEnabled)
+    {
+        TextEx(text, text_end, ImGuiTextFlags_NoWidthForLargeClippedText);
+        return;
+    }
+
+    // Index appended text (a smaller buffer means it has been cleared or replaced)
+    const int text_size = (int)(text_end - text);
+    if (text_size < index->EndOffset)
+        index->clear();
+    index->append(text, index->EndOffset, text_size);
+
+    // Measure complete lines that haven't been measured yet. The last line may still grow so it is measured every frame.
+    if (index->WidthFont != g.Font || index->WidthFontSize != g.FontSize)
+    {
+        index->WidthLinesCount = 0;
+        index->WidthMax = 0.0f;
+        index->WidthFont = g.Font;
+        index->WidthFontSize = g.FontSize;
+    }
+    const int lines_count = index->size();
+    for (; index->WidthLinesCount < lines_count - 1; index->WidthLinesCount++)
+        index->WidthMax = ImMax(index->WidthMax, CalcTextSize(index->get_line_begin(text, index->WidthLinesCount), index->get_line_end(text, index->WidthLinesCount)).x);
+    float width = index->WidthMax;
+    if (lines_count > 0)
+        width = ImMax(width, CalcTextSize(index->get_line_begin(text, lines_count - 1), index->get_line_end(text, lines_count - 1)).x);
+
+    // Render visible lines
+    const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
+    const float line_height = GetTextLineHeight();
+    const int line_first = ImClamp((int)((window->ClipRect.Min.y - text_pos.y) / line_height), 0, lines_count);
+    const int line_last = ImClamp((int)ImCeil((window->ClipRect.Max.y - text_pos.y) / line_height), line_first, lines_count);
+    for (int line_n = line_first; line_n < line_last; line_n++)
+        RenderText(ImVec2(text_pos.x, text_pos.y + line_n * line_height), index->get_line_begin(text, line_n), index->get_line_end(text, line_n), false);
+
+    const ImVec2 size(width, ImMax(lines_count, 1) * line_height);
+    ImRect bb(text_pos, text_pos + size);
+    ItemSize(size, 0.0f);
+    ItemAdd(bb, 0);
+}
+
 void ImGui::Text(const char* fmt, ...)
 {
     va_list args;
@@ -3255,6 +3313,66 @@ static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* t
     return text_size;
 }
 
+// Line index of the edit buffer: offsets of the beginning of each line in both TextW and TextA, so we can locate lines
+// and convert positions without scanning the whole text. Rebuilt when TextW is written as a whole, otherwise updated
+// by STB_TEXTEDIT_DELETECHARS()/STB_TEXTEDIT_INSERTCHARS().
+static void InputTextLineIndexRebuild(ImGuiInputTextState* state)
+{
+    state->LineStartsW.resize(1);
+    state->LineStartsA.resize(1);
+    state->LineStartsW[0] = state->LineStartsA[0] = 0;
+    const ImWchar* text = state->TextW.Data;
+    int line_start_w = 0, line_start_a = 0;
+    for (int n = 0; n < state->CurLenW; n++)
+        if (text[n] == '\n')
+        {
+            line_start_a += ImTextCountUtf8BytesFromStr(text + line_start_w, text + n + 1);
+            line_start_w = n + 1;
+            state->LineStartsW.push_back(line_start_w);
+            state->LineStartsA.push_back(line_start_a);
+        }
+}
+
+// Return the line containing character 'pos_w' (the last line starting at or before it)
+static int InputTextLineIndexFind(const ImGuiInputTextState* state, int pos_w)
+{
+    const int* line_starts = state->LineStartsW.Data;
+    int first = 0;
+    int count = state->LineStartsW.Size;
+    while (count > 0)
+    {
+        const int step = count >> 1;
+        if (line_starts[first + step] <= pos_w)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    IM_ASSERT(first > 0);
+    return first - 1;
+}
+
+static int InputTextOffsetWToA(const ImGuiInputTextState* state, int pos_w)
+{
+    const int line = InputTextLineIndexFind(state, pos_w);
+    const ImWchar* line_start = state->TextW.Data + state->LineStartsW[line];
+    return state->LineStartsA[line] + ImTextCountUtf8BytesFromStr(line_start, state->TextW.Data + pos_w);
+}
+
+// Convert TextW to TextA and rebuild the line index. TextA holds at least 'buf_size' bytes so user callbacks can write into it.
+static void InputTextSyncTextAFromTextW(ImGuiInputTextState* state, int buf_size)
+{
+    const int text_len_a = ImTextCountUtf8BytesFromStr(state->TextW.Data, state->TextW.Data + state->CurLenW);
+    state->TextA.resize(ImMax(buf_size, text_len_a + 1));
+    state->CurLenA = ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, state->TextW.Data + state->CurLenW);
+    state->TextAIsValid = true;
+    InputTextLineIndexRebuild(state);
+}
+
 // Wrapper for stb_textedit.h to edit text (our wrapper is for: statically sized buffer, single-line, wchar characters. InputText converts between UTF-8 and wchar)
 namespace ImStb
 {
@@ -3289,19 +3407,53 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 #define STB_TEXTEDIT_MOVEWORDLEFT   STB_TEXTEDIT_MOVEWORDLEFT_IMPL    // They need to be #define for stb_textedit.h
 #define STB_TEXTEDIT_MOVEWORDRIGHT  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL
 
-static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
+// Rows are lines (we don't do word-wrapping), so the line index lets stb_textedit.h skip laying out all the rows preceding the one it looks for
+static int STB_TEXTEDIT_ROWSTART_FOR_CHAR_IMPL(STB_TEXTEDIT_STRING* obj, int idx, int* out_prev_row_start, float* out_row_y)
 {
-    ImWchar* dst = obj->TextW.Data + pos;
+    const int line = InputTextLineIndexFind(obj, idx);
+    *out_prev_row_start = obj->LineStartsW[ImMax(line - 1, 0)];
+    *out_row_y = line * GImGui->FontSize;
+    return obj->LineStartsW[line];
+}
+static int STB_TEXTEDIT_ROWSTART_FOR_Y_IMPL(STB_TEXTEDIT_STRING* obj, float y, float* out_row_y)
+{
+    // Start one row early: stb_textedit.h accumulates row heights so its row boundaries may differ from ours by rounding
+    const float line_height = GImGui->FontSize;
+    const int line = ImClamp((int)(y / line_height) - 1, 0, obj->LineStartsW.Size - 1);
+    *out_row_y = line * line_height;
+    return obj->LineStartsW[line];
+}
+#define STB_TEXTEDIT_ROWSTART_FOR_CHAR  STB_TEXTEDIT_ROWSTART_FOR_CHAR_IMPL
+#define STB_TEXTEDIT_ROWSTART_FOR_Y     STB_TEXTEDIT_ROWSTART_FOR_Y_IMPL
 
-    // We maintain our buffer length in both UTF-8 and wchar formats
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
+{
+    // We maintain our buffer contents and length in both UTF-8 and wchar formats
+    IM_ASSERT(obj->TextAIsValid);
+    ImWchar* text = obj->TextW.Data;
+    const int line = InputTextLineIndexFind(obj, pos);
+    const int pos_a = obj->LineStartsA[line] + ImTextCountUtf8BytesFromStr(text + obj->LineStartsW[line], text + pos);
+    const int n_a = ImTextCountUtf8BytesFromStr(text + pos, text + pos + n);
+    memmove(text + pos, text + pos + n, (size_t)(obj->CurLenW - pos - n + 1) * sizeof(ImWchar));
+    memmove(obj->TextA.Data + pos_a, obj->TextA.Data + pos_a + n_a, (size_t)(obj->CurLenA - pos_a - n_a + 1));
     obj->CurLenW -= n;
+    obj->CurLenA -= n_a;
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Remove lines starting within the deleted text, offset following lines
+    int* line_starts_w = obj->LineStartsW.Data;
+    int* line_starts_a = obj->LineStartsA.Data;
+    const int lines_count = obj->LineStartsW.Size;
+    int remove_end = line + 1;
+    while (remove_end < lines_count && line_starts_w[remove_end] <= pos + n)
+        remove_end++;
+    const int remove_count = remove_end - (line + 1);
+    for (int i = remove_end; i < lines_count; i++)
+    {
+        line_starts_w[i - remove_count] = line_starts_w[i] - n;
+        line_starts_a[i - remove_count] = line_starts_a[i] - n_a;
+    }
+    obj->LineStartsW.resize(lines_count - remove_count);
+    obj->LineStartsA.resize(lines_count - remove_count);
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -3314,7 +3466,7 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     if (!is_resizable && (new_text_len_utf8 + obj->CurLenA + 1 > obj->BufCapacityA))
         return false;
 
-    // Grow internal buffer if needed
+    // Grow internal buffers if needed
     if (new_text_len + text_len + 1 > obj->TextW.Size)
     {
         if (!is_resizable)
@@ -3322,16 +3474,55 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
         IM_ASSERT(text_len < obj->TextW.Size);
         obj->TextW.resize(text_len + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1);
     }
+    if (new_text_len_utf8 + obj->CurLenA + 1 > obj->TextA.Size)
+        obj->TextA.resize(obj->CurLenA + ImClamp(new_text_len_utf8 * 4, 32, ImMax(256, new_text_len_utf8)) + 1);
 
+    IM_ASSERT(obj->TextAIsValid);
     ImWchar* text = obj->TextW.Data;
+    const int line = InputTextLineIndexFind(obj, pos);
+    const int pos_a = obj->LineStartsA[line] + ImTextCountUtf8BytesFromStr(text + obj->LineStartsW[line], text + pos);
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
     memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
 
+    // ImTextStrToUtf8() writes a zero-terminator over the first character following the inserted text, restore it
+    char* text_a = obj->TextA.Data;
+    memmove(text_a + pos_a + new_text_len_utf8, text_a + pos_a, (size_t)(obj->CurLenA - pos_a + 1));
+    const char text_a_next_char = text_a[pos_a + new_text_len_utf8];
+    ImTextStrToUtf8(text_a + pos_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+    text_a[pos_a + new_text_len_utf8] = text_a_next_char;
+
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->TextW[obj->CurLenW] = '\0';
 
+    // Offset following lines, add lines started by the inserted text
+    int new_lines_count = 0;
+    for (int n = 0; n < new_text_len; n++)
+        if (new_text[n] == '\n')
+            new_lines_count++;
+    const int lines_count = obj->LineStartsW.Size;
+    obj->LineStartsW.resize(lines_count + new_lines_count);
+    obj->LineStartsA.resize(lines_count + new_lines_count);
+    int* line_starts_w = obj->LineStartsW.Data;
+    int* line_starts_a = obj->LineStartsA.Data;
+    for (int i = lines_count - 1; i > line; i--)
+    {
+        line_starts_w[i + new_lines_count] = line_starts_w[i] + new_text_len;
+        line_starts_a[i + new_lines_count] = line_starts_a[i] + new_text_len_utf8;
+    }
+    int line_start_a = pos_a;
+    const ImWchar* line_start = new_text;
+    for (int n = 0, dst = line + 1; n < new_text_len; n++)
+        if (new_text[n] == '\n')
+        {
+            line_start_a += ImTextCountUtf8BytesFromStr(line_start, new_text + n + 1);
+            line_start = new_text + n + 1;
+            line_starts_w[dst] = pos + n + 1;
+            line_starts_a[dst] = line_start_a;
+            dst++;
+        }
+
     return true;
 }
 
@@ -3619,12 +3810,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         memcpy(state->InitialTextA.Data, buf, buf_len + 1);
 
         // Start edition
-        const char* buf_end = NULL;
         state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
-        state->TextA.resize(0);
-        state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
-        state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL);
+        InputTextSyncTextAFromTextW(state, buf_size); // TextA is converted back from TextW so they match even if 'buf' has malformed UTF-8. Edits then update both of them.
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
@@ -3691,6 +3879,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextW.resize(buf_size + 1);
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);
+        state->TextAIsValid = false;
+        InputTextLineIndexRebuild(state);
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -3721,6 +3911,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     if (g.ActiveId == id)
     {
         IM_ASSERT(state != NULL);
+        if (!is_readonly && !state->TextAIsValid)
+            InputTextSyncTextAFromTextW(state, buf_size);
         backup_current_text_length = state->CurLenA;
         state->BufCapacityA = buf_size;
         state->UserFlags = flags;
@@ -3872,10 +4064,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = g.FrameArena.AllocArray<char>(clipboard_data_len);
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
             }
             if (is_cut)
             {
@@ -3891,7 +4082,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len+1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = g.FrameArena.AllocArray<ImWchar>(clipboard_len + 1);
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -3909,7 +4100,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
             }
         }
 
@@ -3931,13 +4121,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 // Push records into the undo stack so we can CTRL+Z the revert operation itself
                 apply_new_text = state->InitialTextA.Data;
                 apply_new_text_length = state->InitialTextA.Size - 1;
-                ImVector<ImWchar> w_text;
+                ImWchar* w_text = NULL;
+                int w_text_len = 0;
                 if (apply_new_text_length > 0)
                 {
-                    w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
-                    ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
+                    const int w_text_size = ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1;
+                    w_text = g.FrameArena.AllocArray<ImWchar>(w_text_size);
+                    w_text_len = ImTextStrFromUtf8(w_text, w_text_size, apply_new_text, apply_new_text + apply_new_text_length);
                 }
-                stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
+                stb_textedit_replace(state, &state->Stb, w_text, w_text_len);
             }
         }
 
@@ -3947,16 +4139,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         bool apply_edit_back_to_user_buffer = !cancel_edit || (enter_pressed && (flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0);
         if (apply_edit_back_to_user_buffer)
         {
-            // Apply new value immediately - copy modified buffer back
+            // Apply new value immediately - copy modified buffer back (TextA is kept up to date by the stb_textedit callbacks)
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
-            if (!is_readonly)
-            {
-                state->TextAIsValid = true;
-                state->TextA.resize(state->TextW.Size * 4 + 1);
-                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
-            }
 
             // User callback
             if ((flags & (ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory | ImGuiInputTextFlags_CallbackAlways)) != 0)
@@ -3986,6 +4171,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
 
                 if (event_flag)
                 {
+                    if (state->TextA.Size < state->BufCapacityA)
+                        state->TextA.resize(state->BufCapacityA);
+
                     ImGuiInputTextCallbackData callback_data;
                     memset(&callback_data, 0, sizeof(ImGuiInputTextCallbackData));
                     callback_data.EventFlag = event_flag;
@@ -3998,11 +4186,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.BufSize = state->BufCapacityA;
                     callback_data.BufDirty = false;
 
-                    // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
-                    ImWchar* text = state->TextW.Data;
-                    const int utf8_cursor_pos = callback_data.CursorPos = ImTextCountUtf8BytesFromStr(text, text + state->Stb.cursor);
-                    const int utf8_selection_start = callback_data.SelectionStart = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_start);
-                    const int utf8_selection_end = callback_data.SelectionEnd = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_end);
+                    // We have to convert from wchar-positions to UTF-8-positions (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188), the line index makes it proportional to the line length.
+                    const int utf8_cursor_pos = callback_data.CursorPos = InputTextOffsetWToA(state, state->Stb.cursor);
+                    const int utf8_selection_start = callback_data.SelectionStart = InputTextOffsetWToA(state, state->Stb.select_start);
+                    const int utf8_selection_end = callback_data.SelectionEnd = InputTextOffsetWToA(state, state->Stb.select_end);
 
                     // Call user code
                     callback(&callback_data);
@@ -4021,6 +4208,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length));
                         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        if (state->TextA.Size < state->CurLenA + 1)
+                            state->TextA.resize(state->CurLenA + 1); // InsertChars() may have only reserved TextA, this doesn't reallocate
+                        InputTextLineIndexRebuild(state);
                         state->CursorAnimReset();
                     }
                 }
@@ -4114,54 +4304,24 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         const ImWchar* text_begin = state->TextW.Data;
         ImVec2 cursor_offset, select_start_offset;
 
+        int select_start_line = 0;
         {
-            // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
-            const ImWchar* searches_input_ptr[2] = { NULL, NULL };
-            int searches_result_line_no[2] = { -1000, -1000 };
-            int searches_remaining = 0;
-            if (render_cursor)
-            {
-                searches_input_ptr[0] = text_begin + state->Stb.cursor;
-                searches_result_line_no[0] = -1;
-                searches_remaining++;
-            }
+            // Find lines numbers of 'cursor' and 'select_start' positions using the line index.
+            // Calculate 2d position by measuring distance from the beginning of the line.
+            const int cursor_line = InputTextLineIndexFind(state, state->Stb.cursor);
+            cursor_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[cursor_line], text_begin + state->Stb.cursor).x;
+            cursor_offset.y = (cursor_line + 1) * g.FontSize;
             if (render_selection)
             {
-                searches_input_ptr[1] = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-                searches_result_line_no[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_no[0] * g.FontSize;
-            if (searches_result_line_no[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_no[1] * g.FontSize;
+                const int select_start = ImMin(state->Stb.select_start, state->Stb.select_end);
+                select_start_line = InputTextLineIndexFind(state, select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[select_start_line], text_begin + select_start).x;
+                select_start_offset.y = (select_start_line + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
             if (is_multiline)
-                text_size = ImVec2(inner_size.x, line_count * g.FontSize);
+                text_size = ImVec2(inner_size.x, state->LineStartsW.Size * g.FontSize);
         }
 
         // Scroll
@@ -4207,17 +4367,18 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            int line = select_start_line;
+            for (const ImWchar* p = text_selected_begin; p < text_selected_end; line++)
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
                     break;
                 if (rect_pos.y < clip_rect.y)
                 {
-                    //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
-                    //p = p ? p + 1 : text_selected_end;
-                    while (p < text_selected_end)
-                        if (*p++ == '\n')
-                            break;
+                    // Skip lines above clipping rectangle using the line index
+                    const int lines_skip = ImMax((int)((clip_rect.y - rect_pos.y) / g.FontSize), 1);
+                    line += lines_skip - 1;
+                    rect_pos.y += (lines_skip - 1) * g.FontSize;
+                    p = (line + 1 < state->LineStartsW.Size) ? ImMin(text_begin + state->LineStartsW[line + 1], text_selected_end) : text_selected_end;
                 }
                 else
                 {
@@ -4236,8 +4397,17 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
         if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
+            // Skip lines above clipping rectangle using the line index (one less so ImFont::RenderText() makes the final decision)
+            ImVec2 text_pos = draw_pos - draw_scroll;
+            const char* buf_display_begin = buf_display;
+            if (is_multiline && buf_display_from_state && !is_displaying_hint)
+            {
+                const int lines_skip = ImClamp((int)((draw_window->DrawList->GetClipRectMin().y - text_pos.y) / g.FontSize) - 1, 0, state->LineStartsA.Size - 1);
+                buf_display_begin += state->LineStartsA[lines_skip];
+                text_pos.y += lines_skip * g.FontSize;
+            }
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
-            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
+            draw_window->DrawList->AddText(g.Font, g.FontSize, text_pos, col, buf_display_begin, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
         }
 
         // Draw blinking cursor
@@ -4306,6 +4476,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
 // - ColorEdit4()
 // - ColorPicker3()
 // - RenderColorRectWithAlphaCheckerboard() [Internal]
+// - RenderColorPickerHueWheel() [Internal]
 // - ColorPicker4()
 // - ColorButton()
 // - SetColorEditOptions()
@@ -4578,6 +4749,111 @@ static void RenderArrowsForVerticalBar(ImDrawList* draw_list, ImVec2 pos, ImVec2
     ImGui::RenderArrowPointingAt(draw_list, ImVec2(pos.x + bar_w - half_sz.x,     pos.y), half_sz,                              ImGuiDir_Left,  IM_COL32(255,255,255,alpha8));
 }
 
+// Helper for RenderColorPickerHueWheel(): 6 arcs whose vertices are shaded from one hue to the next
+static void RenderHueWheelArcs(ImDrawList* draw_list, ImVec2 center, float radius_inner, float radius_outer, int alpha8)
+{
+    const ImU32 col_white = IM_COL32(255,255,255,alpha8);
+    const ImU32 col_hues[6 + 1] = { IM_COL32(255,0,0,alpha8), IM_COL32(255,255,0,alpha8), IM_COL32(0,255,0,alpha8), IM_COL32(0,255,255,alpha8), IM_COL32(0,0,255,alpha8), IM_COL32(255,0,255,alpha8), IM_COL32(255,0,0,alpha8) };
+    const float aeps = 0.5f / radius_outer; // Half a pixel arc length in radians (2pi cancels out).
+    const int segment_per_arc = ImMax(4, (int)radius_outer / 12);
+    for (int n = 0; n < 6; n++)
+    {
+        const float a0 = (n)     /6.0f * 2.0f * IM_PI - aeps;
+        const float a1 = (n+1.0f)/6.0f * 2.0f * IM_PI + aeps;
+        const int vert_start_idx = draw_list->VtxBuffer.Size;
+        draw_list->PathArcTo(center, (radius_inner + radius_outer)*0.5f, a0, a1, segment_per_arc);
+        draw_list->PathStroke(col_white, false, radius_outer - radius_inner);
+        const int vert_end_idx = draw_list->VtxBuffer.Size;
+
+        // Paint colors over existing vertices
+        ImVec2 gradient_p0(center.x + ImCos(a0) * radius_inner, center.y + ImSin(a0) * radius_inner);
+        ImVec2 gradient_p1(center.x + ImCos(a1) * radius_inner, center.y + ImSin(a1) * radius_inner);
+        ImGui::ShadeVertsLinearColorGradientKeepAlpha(draw_list, vert_start_idx, vert_end_idx, gradient_p0, gradient_p1, col_hues[n], col_hues[n+1]);
+    }
+}
+
+// Hue wheel of ColorPicker4(). The mesh only depends on the radii, the sub-pixel position of the center and anti-aliasing, so unless 'use_cache'
+// is false it is generated once in a temporary draw list (relative to the integer part of the center, at full alpha), then copied with an offset
+// and the alpha applied. Vertices and indices are the same as when generated in place, give or take float rounding of positions.
+void ImGui::RenderColorPickerHueWheel(ImDrawList* draw_list, ImVec2 center, float radius_inner, float radius_outer, float alpha, bool use_cache)
+{
+    ImGuiContext& g = *GImGui;
+    const int alpha8 = IM_F32_TO_INT8_SAT(alpha);
+    if (!use_cache)
+    {
+        RenderHueWheelArcs(draw_list, center, radius_inner, radius_outer, alpha8);
+        return;
+    }
+
+    const ImVec2 center_offset(ImFloor(center.x), ImFloor(center.y));
+    const ImVec2 center_frac(center.x - center_offset.x, center.y - center_offset.y);
+    const ImDrawListFlags flags = draw_list->Flags & ImDrawListFlags_AntiAliasedLines;
+    const ImVec2 uv_white = draw_list->_Data->TexUvWhitePixel;
+    ImGuiColorPickerMesh* mesh = NULL;
+    for (int n = 0; n < g.ColorPickerMeshes.Size && mesh == NULL; n++)
+    {
+        ImGuiColorPickerMesh* candidate = g.ColorPickerMeshes[n];
+        if (candidate->RadiusInner == radius_inner && candidate->RadiusOuter == radius_outer && candidate->CenterFrac.x == center_frac.x && candidate->CenterFrac.y == center_frac.y
+            && candidate->Flags == flags && candidate->TexUvWhitePixel.x == uv_white.x && candidate->TexUvWhitePixel.y == uv_white.y)
+            mesh = candidate;
+    }
+    if (mesh == NULL)
+    {
+        // Reuse the least recently used mesh once the cache is full
+        if (g.ColorPickerMeshes.Size < IMGUI_COLOR_PICKER_MESH_CACHE_SIZE)
+        {
+            mesh = IM_NEW(ImGuiColorPickerMesh)();
+            g.ColorPickerMeshes.push_back(mesh);
+        }
+        else
+        {
+            mesh = g.ColorPickerMeshes[0];
+            for (int n = 1; n < g.ColorPickerMeshes.Size; n++)
+                if (g.ColorPickerMeshes[n]->LastFrameUsed < mesh->LastFrameUsed)
+                    mesh = g.ColorPickerMeshes[n];
+        }
+        mesh->RadiusInner = radius_inner;
+        mesh->RadiusOuter = radius_outer;
+        mesh->CenterFrac = center_frac;
+        mesh->Flags = flags;
+        mesh->TexUvWhitePixel = uv_white;
+
+        ImDrawList mesh_draw_list(draw_list->_Data);
+        mesh_draw_list.Flags = flags;
+        mesh_draw_list.PushClipRectFullScreen();
+        RenderHueWheelArcs(&mesh_draw_list, center_frac, radius_inner, radius_outer, 255);
+        const int vtx_count = mesh_draw_list.VtxBuffer.Size;
+        mesh->VtxPos.resize(vtx_count);
+        mesh->VtxUV.resize(vtx_count);
+        mesh->VtxCol.resize(vtx_count);
+        for (int n = 0; n < vtx_count; n++)
+        {
+            const ImDrawVert& vtx = mesh_draw_list.VtxBuffer.Data[n];
+            mesh->VtxPos.Data[n] = ImVec2(vtx.pos);
+            mesh->VtxUV.Data[n] = ImVec2(vtx.uv);
+            mesh->VtxCol.Data[n] = vtx.col;
+        }
+        mesh->IdxBuffer = mesh_draw_list.IdxBuffer;
+    }
+    mesh->LastFrameUsed = g.FrameCount;
+
+    const int vtx_count = mesh->VtxPos.Size;
+    const int idx_count = mesh->IdxBuffer.Size;
+    draw_list->PrimReserve(idx_count, vtx_count);
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+    for (int n = 0; n < idx_count; n++)
+        draw_list->_IdxWritePtr[n] = (ImDrawIdx)(idx_base + mesh->IdxBuffer.Data[n]);
+    draw_list->_IdxWritePtr += idx_count;
+    for (int n = 0; n < vtx_count; n++)
+    {
+        ImU32 col = mesh->VtxCol.Data[n];
+        if (alpha8 != 255)
+            col = (col & ~IM_COL32_A_MASK) | ((((col >> IM_COL32_A_SHIFT) & 0xFF) * alpha8 / 255) << IM_COL32_A_SHIFT);
+        const ImVec2& pos = mesh->VtxPos.Data[n];
+        draw_list->PrimWriteVtx(ImVec2(pos.x + center_offset.x, pos.y + center_offset.y), mesh->VtxUV.Data[n], col);
+    }
+}
+
 // Note: ColorPicker4() only accesses 3 floats if ImGuiColorEditFlags_NoAlpha flag is set.
 // (In C++ the 'float col[4]' notation for a function argument is equivalent to 'float* col', we only specify a size to facilitate understanding of the code.)
 // FIXME: we adjust the big color square height based on item width, which may cause a flickering feedback loop (if automatic height makes a vertical scrollbar appears, affecting automatic width..)
@@ -4868,22 +5144,7 @@ bool ImGui::ColorPicker4(const char* label, float col[4], ImGuiColorEditFlags fl
     if (flags & ImGuiColorEditFlags_PickerHueWheel)
     {
         // Render Hue Wheel
-        const float aeps = 0.5f / wheel_r_outer; // Half a pixel arc length in radians (2pi cancels out).
-        const int segment_per_arc = ImMax(4, (int)wheel_r_outer / 12);
-        for (int n = 0; n < 6; n++)
-        {
-            const float a0 = (n)     /6.0f * 2.0f * IM_PI - aeps;
-            const float a1 = (n+1.0f)/6.0f * 2.0f * IM_PI + aeps;
-            const int vert_start_idx = draw_list->VtxBuffer.Size;
-            draw_list->PathArcTo(wheel_center, (wheel_r_inner + wheel_r_outer)*0.5f, a0, a1, segment_per_arc);
-            draw_list->PathStroke(col_white, false, wheel_thickness);
-            const int vert_end_idx = draw_list->VtxBuffer.Size;
-
-            // Paint colors over existing vertices
-            ImVec2 gradient_p0(wheel_center.x + ImCos(a0) * wheel_r_inner, wheel_center.y + ImSin(a0) * wheel_r_inner);
-            ImVec2 gradient_p1(wheel_center.x + ImCos(a1) * wheel_r_inner, wheel_center.y + ImSin(a1) * wheel_r_inner);
-            ShadeVertsLinearColorGradientKeepAlpha(draw_list, vert_start_idx, vert_end_idx, gradient_p0, gradient_p1, col_hues[n], col_hues[n+1]);
-        }
+        RenderColorPickerHueWheel(draw_list, wheel_center, wheel_r_inner, wheel_r_outer, style.Alpha);
 
         // Render Cursor + preview on Hue Wheel
         float cos_hue_angle = ImCos(H * 2.0f * IM_PI);
@@ -5909,11 +6170,166 @@ bool ImGui::ListBox(const char* label, int* current_item, bool (*items_getter)(v
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: PlotLines, PlotHistogram
 //-------------------------------------------------------------------------
+// - SetNextPlotDataVersion()
+// - PlotCacheXXX() [Internal]
 // - PlotEx() [Internal]
 // - PlotLines()
 // - PlotHistogram()
 //-------------------------------------------------------------------------
 
+struct ImGuiPlotArrayGetterData
+{
+    const float* Values;
+    int Stride;
+
+    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
+};
+
+static float Plot_ArrayGetter(void* data, int idx)
+{
+    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
+    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
+    return v;
+}
+
+void ImGui::SetNextPlotDataVersion(int data_version)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextItemData.Flags |= ImGuiNextItemDataFlags_HasPlotDataVersion;
+    g.NextItemData.PlotDataVersion = data_version;
+}
+
+static inline void PlotAccumulateMinMax(float v_min, float v_max, float* out_min, float* out_max)
+{
+    if (v_min < *out_min) *out_min = v_min; // NaN values never pass those tests
+    if (v_max > *out_max) *out_max = v_max;
+}
+
+// Return the cache for a plot, rebuilding its min/max pyramid if the data identity or version changed.
+static ImGuiPlotCache* PlotCacheGet(ImGuiID id, float (*values_getter)(void* data, int idx), void* data, int values_count, int data_version)
+{
+    ImGuiContext& g = *GImGui;
+
+    // Identify array data by their values pointer, as ImGuiPlotArrayGetterData is a temporary
+    const void* data_key = data;
+    int data_stride = 0;
+    if (values_getter == &Plot_ArrayGetter)
+    {
+        data_key = ((ImGuiPlotArrayGetterData*)data)->Values;
+        data_stride = ((ImGuiPlotArrayGetterData*)data)->Stride;
+    }
+
+    const int cache_idx = g.PlotCachesById.GetInt(id, -1);
+    ImGuiPlotCache* cache = (cache_idx != -1) ? g.PlotCaches[cache_idx] : NULL;
+    if (cache == NULL)
+    {
+        cache = IM_NEW(ImGuiPlotCache)();
+        cache->ID = id;
+        cache->Version = data_version - 1;
+        g.PlotCachesById.SetInt(id, g.PlotCaches.Size);
+        g.PlotCaches.push_back(cache);
+    }
+    cache->LastTimeUsed = (float)g.Time;
+    if (cache->Data == data_key && cache->Count == values_count && cache->Stride == data_stride && cache->Version == data_version && cache->MinMax.Size > 0)
+        return cache;
+
+    cache->Data = data_key;
+    cache->Count = values_count;
+    cache->Stride = data_stride;
+    cache->Version = data_version;
+
+    // Level 0: blocks of IMGUI_PLOT_CACHE_BLOCK_SIZE samples (the last one may be partial)
+    const int block_size = IMGUI_PLOT_CACHE_BLOCK_SIZE;
+    int level_size = (values_count + block_size - 1) / block_size;
+    cache->MinMax.reserve(level_size * 4 + 2);
+    cache->MinMax.resize(level_size * 2);
+    cache->LevelOffsets.resize(0);
+    cache->LevelOffsets.push_back(0);
+    for (int block_n = 0; block_n < level_size; block_n++)
+    {
+        float v_min = FLT_MAX, v_max = -FLT_MAX;
+        for (int idx = block_n * block_size, idx_end = ImMin(idx + block_size, values_count); idx < idx_end; idx++)
+        {
+            const float v = values_getter(data, idx);
+            PlotAccumulateMinMax(v, v, &v_min, &v_max);
+        }
+        cache->MinMax[block_n * 2 + 0] = v_min;
+        cache->MinMax[block_n * 2 + 1] = v_max;
+    }
+
+    // Upper levels: each block covers two blocks of the previous level
+    while (level_size > 1)
+    {
+        const int src_offset = cache->LevelOffsets.back();
+        const int dst_offset = cache->MinMax.Size;
+        const int src_size = level_size;
+        level_size = (level_size + 1) / 2;
+        cache->LevelOffsets.push_back(dst_offset);
+        cache->MinMax.resize(dst_offset + level_size * 2);
+        const float* src = cache->MinMax.Data + src_offset;
+        float* dst = cache->MinMax.Data + dst_offset;
+        for (int block_n = 0; block_n < level_size; block_n++)
+        {
+            float v_min = src[block_n * 4 + 0], v_max = src[block_n * 4 + 1];
+            if (block_n * 2 + 1 < src_size)
+                PlotAccumulateMinMax(src[block_n * 4 + 2], src[block_n * 4 + 3], &v_min, &v_max);
+            dst[block_n * 2 + 0] = v_min;
+            dst[block_n * 2 + 1] = v_max;
+        }
+    }
+    cache->MinValue = cache->MinMax[cache->LevelOffsets.back() + 0];
+    cache->MaxValue = cache->MinMax[cache->LevelOffsets.back() + 1];
+    return cache;
+}
+
+// Accumulate min/max of values [idx_begin, idx_end): we read unaligned samples at both ends, then walk up the pyramid.
+static void PlotCacheQuery(const ImGuiPlotCache* cache, float (*values_getter)(void* data, int idx), void* data, int idx_begin, int idx_end, float* out_min, float* out_max)
+{
+    const int block_size = IMGUI_PLOT_CACHE_BLOCK_SIZE;
+    while (idx_begin < idx_end && (idx_begin % block_size) != 0)
+    {
+        const float v = values_getter(data, idx_begin++);
+        PlotAccumulateMinMax(v, v, out_min, out_max);
+    }
+    while (idx_begin < idx_end && (idx_end % block_size) != 0 && idx_end != cache->Count)
+    {
+        const float v = values_getter(data, --idx_end);
+        PlotAccumulateMinMax(v, v, out_min, out_max);
+    }
+    if (idx_begin >= idx_end)
+        return;
+
+    int block_begin = idx_begin / block_size;
+    int block_end = (idx_end + block_size - 1) / block_size;
+    for (int level = 0; block_begin < block_end; level++)
+    {
+        const float* level_data = cache->MinMax.Data + cache->LevelOffsets[level];
+        if (block_begin & 1)
+        {
+            PlotAccumulateMinMax(level_data[block_begin * 2 + 0], level_data[block_begin * 2 + 1], out_min, out_max);
+            block_begin++;
+        }
+        if (block_end & 1)
+        {
+            block_end--;
+            PlotAccumulateMinMax(level_data[block_end * 2 + 0], level_data[block_end * 2 + 1], out_min, out_max);
+        }
+        block_begin >>= 1;
+        block_end >>= 1;
+    }
+}
+
+// Same as above but using logical plot indices, which are rotated by values_offset.
+static void PlotCacheQueryRotated(const ImGuiPlotCache* cache, float (*values_getter)(void* data, int idx), void* data, int values_offset, int idx_begin, int idx_end, float* out_min, float* out_max)
+{
+    const int values_count = cache->Count;
+    const int rotated_begin = (idx_begin + values_offset) % values_count;
+    const int rotated_end = rotated_begin + (idx_end - idx_begin);
+    PlotCacheQuery(cache, values_getter, data, rotated_begin, ImMin(rotated_end, values_count), out_min, out_max);
+    if (rotated_end > values_count)
+        PlotCacheQuery(cache, values_getter, data, 0, rotated_end - values_count, out_min, out_max);
+}
+
 int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 frame_size)
 {
     ImGuiContext& g = *GImGui;
@@ -5924,6 +6340,10 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     const ImGuiStyle& style = g.Style;
     const ImGuiID id = window->GetID(label);
 
+    // Read before ItemAdd() which clears NextItemData
+    const bool use_cache = (g.NextItemData.Flags & ImGuiNextItemDataFlags_HasPlotDataVersion) != 0;
+    const int data_version = g.NextItemData.PlotDataVersion;
+
     const ImVec2 label_size = CalcTextSize(label, NULL, true);
     if (frame_size.x == 0.0f)
         frame_size.x = CalcItemWidth();
@@ -5938,8 +6358,18 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
         return -1;
     const bool hovered = ItemHoverable(frame_bb, id);
 
+    // Decimation (see SetNextPlotDataVersion()): scan the values only when they changed
+    ImGuiPlotCache* cache = (use_cache && values_count > 0) ? PlotCacheGet(id, values_getter, data, values_count, data_version) : NULL;
+
     // Determine scale from values if not specified
-    if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+    if (cache && (scale_min == FLT_MAX || scale_max == FLT_MAX))
+    {
+        if (scale_min == FLT_MAX)
+            scale_min = cache->MinValue;
+        if (scale_max == FLT_MAX)
+            scale_max = cache->MaxValue;
+    }
+    else if (scale_min == FLT_MAX || scale_max == FLT_MAX)
     {
         float v_min = FLT_MAX;
         float v_max = -FLT_MAX;
@@ -5960,8 +6390,73 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
 
     const int values_count_min = (plot_type == ImGuiPlotType_Lines) ? 2 : 1;
+    const int columns_count = (int)inner_bb.GetWidth();
     int idx_hovered = -1;
-    if (values_count >= values_count_min)
+    if (cache && values_count > columns_count && columns_count > 0)
+    {
+        // Decimated: each pixel column displays the [min,max] range of its samples
+        const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+        const float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (-scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);
+        const float column_w = inner_bb.GetWidth() / (float)columns_count;
+        const ImU32 col_base = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+        const ImU32 col_hovered = GetColorU32((plot_type == ImGuiPlotType_Lines) ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+
+        int column_hovered = -1;
+        if (hovered && inner_bb.Contains(g.IO.MousePos))
+            column_hovered = ImClamp((int)((g.IO.MousePos.x - inner_bb.Min.x) / column_w), 0, columns_count - 1);
+
+        ImDrawList* draw_list = window->DrawList;
+        ImRect hovered_rect(0.0f, 0.0f, 0.0f, 0.0f);
+        float prev_y = 0.0f;
+        for (int column_n = 0; column_n < columns_count; column_n++)
+        {
+            const int idx_begin = (int)(((long long)column_n * values_count) / columns_count);
+            const int idx_end = (int)(((long long)(column_n + 1) * values_count) / columns_count);
+            float v_min = FLT_MAX, v_max = -FLT_MAX;
+            PlotCacheQueryRotated(cache, values_getter, data, values_offset, idx_begin, idx_end, &v_min, &v_max);
+            if (column_n == column_hovered)
+            {
+                if (v_min <= v_max)
+                    SetTooltip("%d..%d: min %8.4g, max %8.4g", idx_begin, idx_end - 1, v_min, v_max);
+                idx_hovered = idx_begin;
+            }
+            if (v_min > v_max)
+            {
+                // Only NaN values: leave a gap
+                if (plot_type == ImGuiPlotType_Lines)
+                    draw_list->PathStroke(col_base, false);
+                continue;
+            }
+
+            const float x0 = inner_bb.Min.x + column_n * column_w;
+            const float y_min = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_min - scale_min) * inv_scale));
+            const float y_max = ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v_max - scale_min) * inv_scale));
+            if (plot_type == ImGuiPlotType_Lines)
+            {
+                // Connect from the closest end of the [min,max] range to the previous column
+                const float x = x0 + column_w * 0.5f;
+                const bool max_first = draw_list->_Path.Size > 0 && ImFabs(prev_y - y_max) < ImFabs(prev_y - y_min);
+                draw_list->PathLineTo(ImVec2(x, (max_first ? y_max : y_min) + 0.5f));
+                if (y_min != y_max)
+                    draw_list->PathLineTo(ImVec2(x, (max_first ? y_min : y_max) + 0.5f));
+                prev_y = max_first ? y_min : y_max;
+                if (column_n == column_hovered)
+                    hovered_rect = ImRect(x0, y_max, x0 + column_w, y_min + 1.0f);
+            }
+            else if (plot_type == ImGuiPlotType_Histogram)
+            {
+                const float y_zero = ImLerp(inner_bb.Min.y, inner_bb.Max.y, histogram_zero_line_t);
+                draw_list->AddRectFilled(ImVec2(x0, ImMin(y_max, y_zero)), ImVec2(x0 + column_w, ImMax(y_min, y_zero)), (column_n == column_hovered) ? col_hovered : col_base);
+            }
+        }
+        if (plot_type == ImGuiPlotType_Lines)
+        {
+            draw_list->PathStroke(col_base, false);
+            if (hovered_rect.Min.x < hovered_rect.Max.x)
+                draw_list->AddRectFilled(hovered_rect.Min, hovered_rect.Max, col_hovered);
+        }
+    }
+    else if (values_count >= values_count_min)
     {
         int res_w = ImMin((int)frame_size.x, values_count) + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
         int item_count = values_count + ((plot_type == ImGuiPlotType_Lines) ? -1 : 0);
@@ -6032,21 +6527,6 @@ int ImGui::PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_get
     return idx_hovered;
 }
 
-struct ImGuiPlotArrayGetterData
-{
-    const float* Values;
-    int Stride;
-
-    ImGuiPlotArrayGetterData(const float* values, int stride) { Values = values; Stride = stride; }
-};
-
-static float Plot_ArrayGetter(void* data, int idx)
-{
-    ImGuiPlotArrayGetterData* plot_data = (ImGuiPlotArrayGetterData*)data;
-    const float v = *(const float*)(const void*)((const unsigned char*)plot_data->Values + (size_t)idx * plot_data->Stride);
-    return v;
-}
-
 void ImGui::PlotLines(const char* label, const float* values, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size, int stride)
 {
     ImGuiPlotArrayGetterData data(values, stride);
@@ -2,6 +2,7 @@
 // This is a slightly modified version of stb_textedit.h 1.13. 
 // Those changes would need to be pushed into nothings/stb:
 // - Fix in stb_textedit_discard_redo (see https://github.com/nothings/stb/issues/321)
+// - Optional STB_TEXTEDIT_ROWSTART_FOR_CHAR/STB_TEXTEDIT_ROWSTART_FOR_Y to skip rows when locating a character or a coordinate
 // Grep for [DEAR IMGUI] to find the changes.
 
 // stb_textedit.h - v1.13  - public domain - Sean Barrett
@@ -169,6 +170,10 @@
 //    STB_TEXTEDIT_K_LINEEND2            secondary keyboard input to move cursor to end of line
 //    STB_TEXTEDIT_K_TEXTSTART2          secondary keyboard input to move cursor to start of text
 //    STB_TEXTEDIT_K_TEXTEND2            secondary keyboard input to move cursor to end of text
+//    STB_TEXTEDIT_ROWSTART_FOR_CHAR(obj,i,int* prev,float* y)  [DEAR IMGUI] returns the first character of the row
+//                                          containing character #i, sets the first character of the previous row and the row y
+//    STB_TEXTEDIT_ROWSTART_FOR_Y(obj,y,float* row_y)           [DEAR IMGUI] returns the first character of a row at or
+//                                          before the one straddling 'y', sets the row y
 //
 // Todo:
 //    STB_TEXTEDIT_K_PGUP        keyboard input to move cursor up a page
@@ -404,6 +409,11 @@ static int stb_text_locate_coord(STB_TEXTEDIT_STRING *str, float x, float y)
    r.ymin = r.ymax = 0;
    r.num_chars = 0;
 
+   // [DEAR IMGUI] Let the user skip rows which are known to be above 'y' (e.g. using a line index)
+   #ifdef STB_TEXTEDIT_ROWSTART_FOR_Y
+   i = STB_TEXTEDIT_ROWSTART_FOR_Y(str, y, &base_y);
+   #endif
+
    // search rows to find one that straddles 'y'
    while (i < n) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
@@ -534,6 +544,13 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
          find->y = 0;
          find->x = 0;
          find->height = 1;
+         // [DEAR IMGUI] Let the user skip to the last row
+         #ifdef STB_TEXTEDIT_ROWSTART_FOR_CHAR
+         if (z > 0) {
+            float row_y;
+            i = STB_TEXTEDIT_ROWSTART_FOR_CHAR(str, z - 1, &prev_start, &row_y);
+         }
+         #endif
          while (i < z) {
             STB_TEXTEDIT_LAYOUTROW(&r, str, i);
             prev_start = i;
@@ -549,6 +566,11 @@ static void stb_textedit_find_charpos(StbFindState *find, STB_TEXTEDIT_STRING *s
    // search rows to find the one that straddles character n
    find->y = 0;
 
+   // [DEAR IMGUI] Let the user skip to the row containing character n (e.g. using a line index)
+   #ifdef STB_TEXTEDIT_ROWSTART_FOR_CHAR
+   i = STB_TEXTEDIT_ROWSTART_FOR_CHAR(str, n, &prev_start, &find->y);
+   #endif
+
    for(;;) {
       STB_TEXTEDIT_LAYOUTROW(&r, str, i);
       if (n < i + r.num_chars)